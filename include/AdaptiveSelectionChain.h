@@ -0,0 +1,108 @@
+// Dear emacs, this is -*- c++ -*-
+#ifndef AdaptiveSelectionChain_H
+#define AdaptiveSelectionChain_H
+
+#include <string>
+#include <vector>
+
+// ROOT include(s):
+#include <Rtypes.h>
+
+// SFrame include(s):
+#include "core/include/SLogger.h"
+#include "include/Selection.h"
+#include "include/BaseCycleContainer.h"
+
+/**
+ *  @short Chain of selection modules which orders itself by measured
+ *         cost and rejection
+ *
+ *  The chain acts as one SelectionModule returning the logical AND of
+ *  its modules. During the first N events all modules of a segment are
+ *  evaluated, their cost per call and independent pass rate are
+ *  measured, and afterwards the modules of each segment are executed in
+ *  order of cost/(1-pass rate), i.e. cheap and strongly rejecting
+ *  modules first.
+ *
+ *  Modules added as non-commutative (e.g. TwoDCut, which needs exactly
+ *  one lepton) are never moved and separate the chain into segments;
+ *  modules are only reordered within a segment.
+ *
+ *  Counting modules added with addCountSelectionModule are dropped if
+ *  another counting module of the same segment counts the same
+ *  collection with a range contained in theirs, e.g. NElectronSelection(1,inf)
+ *  next to NElectronSelection(1,1).
+ *
+ *  The chain keeps its own cut flow in the executed order, including the
+ *  profiling events; dropped modules are reported with the module that
+ *  implies them. Print it with PrintCutFlow().
+ *
+ *  With N=0 the chain is only used to collect the modules, AttachTo()
+ *  then hands them to a standard Selection in the configured order.
+ */
+
+class AdaptiveSelectionChain : public SelectionModule {
+
+public:
+  /// Named constructor, profile_events is the number of events used to measure the modules
+  AdaptiveSelectionChain(const std::string& name, unsigned int profile_events);
+  /// Default destructor, deletes all modules still owned by the chain
+  ~AdaptiveSelectionChain();
+
+  /// Add a module; non-commutative modules keep their position
+  void addSelectionModule(SelectionModule* module, bool commutative=true);
+
+  /// Add a commutative module cutting on the number of objects in the collection named key
+  void addCountSelectionModule(SelectionModule* module, const std::string& key, int min, int max);
+
+  /// Hand all modules in configured order to sel; the chain is empty afterwards
+  void AttachTo(Selection* sel);
+
+  bool pass(BaseCycleContainer* bcc);
+
+  std::string description();
+
+  /// Print the cut flow of the chain in the executed order
+  void PrintCutFlow();
+
+private:
+  struct Entry {
+    SelectionModule* module;
+    std::string key;
+    int min;
+    int max;
+    bool commutative;
+    int implied_by;
+    double time;
+    unsigned long ncalls;
+    unsigned long npass;
+    unsigned long ncutflow;
+  };
+
+  void Setup();
+  bool ProfilePass(BaseCycleContainer* bcc);
+  void Reorder();
+  double Rank(const Entry& entry) const;
+
+  std::string m_name;
+  unsigned int m_profile_events;
+  unsigned int m_nprofiled;
+  bool m_setup;
+  bool m_ordered;
+  unsigned long m_nevents;
+
+  std::vector<Entry> m_entries;
+  // indices into m_entries of the active modules per segment, in execution order
+  std::vector<std::vector<unsigned int> > m_segments;
+  // execution order of all active modules, used for the cut flow
+  std::vector<unsigned int> m_order;
+
+  // evaluated and passed modules (bit = index into m_entries) of the profiling events
+  std::vector<ULong64_t> m_evaluated;
+  std::vector<ULong64_t> m_passed;
+
+  mutable SLogger m_logger;
+
+}; // class AdaptiveSelectionChain
+
+#endif // AdaptiveSelectionChain_H
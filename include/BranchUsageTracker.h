@@ -0,0 +1,110 @@
+// Dear emacs, this is -*- c++ -*-
+#ifndef BranchUsageTracker_H
+#define BranchUsageTracker_H
+
+#include <string>
+#include <vector>
+#include <set>
+
+// ROOT include(s):
+#include <TTree.h>
+#include <TBranch.h>
+
+// SFrame include(s):
+#include "core/include/SLogger.h"
+
+/**
+ *  @short Switches off the input branches not used during the first events
+ *
+ *  All collections named in the XML are connected and read for every
+ *  event, even if the cycle never looks at them. During a learning phase
+ *  of the first N events all branches are read and the tracker records
+ *  which members of the BaseCycleContainer are accessed through Use()
+ *  (e.g. calc->GetJets() becomes tracker->Use(bcc->jets)) or declared with
+ *  Require() for the selection modules and histograms of the framework.
+ *  At the end of the learning phase all other object branches are switched
+ *  off, also for the following input files of the InputData.
+ *
+ *  Using a switched off member later prints a warning, switches the branch
+ *  on again and reads it for the current entry, so the result stays correct
+ *  and only the saving is lost. The collections of switched off branches
+ *  are cleared, so code reading them without Use() finds them empty instead
+ *  of holding an earlier event. Every member of the BaseCycleContainer
+ *  read by framework code (selection modules, histograms, EventCalc
+ *  getters, the Cleaner) must therefore be declared with Require(): a
+ *  missing one is silently emptied after the learning phase, without a
+ *  warning or a fallback. Branches of basic types, trigger
+ *  information, the generator info and the generator jets (used by the
+ *  JER smearing of the Cleaner) are always read.
+ */
+
+class BranchUsageTracker {
+
+public:
+  /// Named constructor
+  BranchUsageTracker(const char* name = "BranchUsageTracker");
+  /// Default destructor
+  ~BranchUsageTracker();
+
+  /// Start a new learning phase of nevents events for the InputData, 0 switches the tracker off
+  void Configure(unsigned long nevents);
+  bool IsActive() const { return m_learn_events>0; }
+
+  /// Declare the member of the BaseCycleContainer (e.g. &bcc->jets) as used
+  void Require(const void* address);
+  /// Declare all space-separated input branches as used
+  void RequireBranches(const std::string& names);
+
+  /// Collect the connected branches of tree, call after connecting the variables
+  void Setup(TTree* tree);
+
+  /// Count the event, ends the learning phase after the configured number of events
+  void Update();
+
+  /// Record the access of a member of the BaseCycleContainer, reads it if it was switched off
+  template<class T> T* Use(T* const& member) {
+    if(m_learning || m_ndisabled) Touch(&member);
+    return member;
+  }
+
+  /// Names of the branches switched off after the learning phase
+  const std::set<std::string>& DisabledBranches() const { return m_disabled_names; }
+
+  /// Print the switched off branches and the branches read again
+  void PrintStatistics();
+
+private:
+  struct ConnectedBranch {
+    TBranch* branch;
+    const void* address;
+    bool enabled;
+  };
+
+  void Touch(const void* address);
+  void Disable();
+  void Clear(const ConnectedBranch& connected);
+  void SetProcess(TBranch* branch, bool process);
+
+  unsigned long m_learn_events;
+  unsigned long m_nevents;
+  bool m_learning;
+  unsigned int m_ndisabled;
+
+  // declared by the cycle, kept for all InputData
+  std::set<const void*> m_required_addresses;
+  std::set<std::string> m_required_names;
+  // accessed during the learning phase of the current InputData
+  std::set<const void*> m_used_addresses;
+  // names of the branches switched off, applied to later input files
+  std::set<std::string> m_disabled_names;
+  std::set<std::string> m_fallback_names;
+
+  TTree* m_tree;
+  TBranch* m_reference;
+  std::vector<ConnectedBranch> m_branches;
+
+  mutable SLogger m_logger;
+
+}; // class BranchUsageTracker
+
+#endif // BranchUsageTracker_H
@@ -10,6 +10,7 @@
 // Local include(s):
 #include "include/BaseHists.h"
 #include "include/BaseCycleContainer.h"
+#include "include/TreeWriter.h"
 
 /**
  *   class for booking and filling histograms to discriminate 
@@ -24,7 +25,7 @@ class CleanerFiller : public BaseHists {
 
 public:
    /// Named constructor
-  CleanerFiller(const char* name, HypothesisDiscriminator *discr, TTree* MetaOutputTree);
+  CleanerFiller(const char* name, HypothesisDiscriminator *discr, TreeWriter* writer);
 
    /// Default destructor
    ~CleanerFiller();
@@ -36,12 +37,12 @@ public:
    void Finish();
 
 private:
-   TTree* m_tree;
+   TreeWriter* m_writer; //!
    
-   Double_t m_toptag;
-   Double_t m_chi2;	
-   Double_t m_mtt_clean;	
-   Double_t m_heptoptag;
+   Int_t* m_toptag; //!
+   Float_t* m_chi2; //!
+   Float_t* m_mtt_clean; //!
+   Int_t* m_heptoptag; //!
 
    HypothesisDiscriminator* m_discr;
 
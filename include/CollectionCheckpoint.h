@@ -0,0 +1,89 @@
+// Dear emacs, this is -*- c++ -*-
+#ifndef CollectionCheckpoint_H
+#define CollectionCheckpoint_H
+
+#include <vector>
+
+/**
+ *  @short Checkpoint of a collection of the BaseCycleContainer
+ *
+ *  Save() copies the collection in one go into a buffer owned by the
+ *  checkpoint which keeps its capacity from event to event. Restore()
+ *  swaps the buffer back into the collection, so no object is copied
+ *  again, and the modified content (e.g. the cleaned jets) stays
+ *  available with Displaced() until the next Save().
+ *
+ *  Usage:
+ *    m_jets_checkpoint->Save(bcc->jets);
+ *    cleaner.JetLeptonSubtractor(m_corrector,false);
+ *    ...
+ *    m_jets_checkpoint->Restore();
+ */
+
+template<typename T>
+class CollectionCheckpoint {
+
+public:
+  CollectionCheckpoint(): m_collection(0), m_saved(false) {}
+
+  /// Save the content of collection
+  void Save(std::vector<T>* collection){
+    m_collection = collection;
+    m_saved = false;
+    if(!collection) return;
+    m_buffer.assign(collection->begin(), collection->end());
+    m_saved = true;
+  }
+
+  /// Put the saved content back into the collection
+  void Restore(){
+    if(!m_saved) return;
+    m_collection->swap(m_buffer);
+    m_saved = false;
+  }
+
+  /// Content of the collection before the last Restore()
+  const std::vector<T>& Displaced() const { return m_buffer; }
+
+  /// True between Save() and Restore()
+  bool IsSaved() const { return m_saved; }
+
+private:
+  std::vector<T>* m_collection;
+  std::vector<T> m_buffer;
+  bool m_saved;
+
+}; // class CollectionCheckpoint
+
+/**
+ *  @short Checkpoint of a single object of the BaseCycleContainer, e.g. the MET
+ */
+
+template<typename T>
+class ObjectCheckpoint {
+
+public:
+  ObjectCheckpoint(): m_object(0) {}
+
+  /// Save the content of object
+  void Save(T* object){
+    m_object = object;
+    if(object) m_saved = *object;
+  }
+
+  /// Put the saved content back into the object
+  void Restore(){
+    if(m_object) *m_object = m_saved;
+    m_object = 0;
+  }
+
+  /// Saved content
+  const T& Saved() const { return m_saved; }
+
+private:
+  T* m_object;
+  T m_saved;
+
+}; // class ObjectCheckpoint
+
+#endif // CollectionCheckpoint_H
@@ -5,6 +5,11 @@
 // SFrame include(s):
 #include "include/AnalysisCycle.h"
 #include "Cleaner.h"
+#include "include/StagedBranchReader.h"
+#include "include/CollectionCheckpoint.h"
+#include "include/OutputPolicy.h"
+#include "include/InputCacheMonitor.h"
+#include "include/EventRandom.h"
 
 /**
  *  @short Selection cycle to perform 
@@ -47,6 +52,29 @@ private:
 
   std::string m_Electron_Or_Muon_Selection;
 
+  // two-stage reading of the input tree
+  bool m_staged_reading;
+  std::string m_staged_early_branches;
+  StagedBranchReader* m_staged_reader;
+
+  // uncleaned jets and MET, written to the output tree
+  CollectionCheckpoint<Jet>* m_jets_checkpoint;
+  ObjectCheckpoint<MET>* m_met_checkpoint;
+
+  std::string m_output_compression;
+  OutputPolicy* m_output_policy;
+
+  // declares the properties InputCache*
+  friend class InputCacheMonitor;
+  InputCacheMonitor* m_input_cache;
+
+  // declares the property DeterministicRandom
+  friend class EventRandom;
+  EventRandom* m_event_random;
+
+  // selections used in ExecuteEvent, set in BeginInputData
+  Selection* m_preselection;
+
   // Macro adding the functions for dictionary generation
   ClassDef( DileptonPreSelectionCycle, 0 );
 
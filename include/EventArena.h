@@ -0,0 +1,97 @@
+// Dear emacs, this is -*- c++ -*-
+#ifndef EventArena_H
+#define EventArena_H
+
+#include <vector>
+
+// SFrame include(s):
+#include "include/BaseCycleContainer.h"
+#include "include/Cleaner.h"
+
+/**
+ *  @short Pool of objects reused from event to event
+ *
+ *  Acquire() hands out objects which stay owned by the pool; Reset()
+ *  makes all of them available again without freeing memory, so
+ *  containers keep their capacity. Acquired objects keep the state of
+ *  their last use, call clear() or assign before using them.
+ */
+
+template<typename T>
+class ObjectPool {
+
+public:
+  ObjectPool(): m_used(0) {}
+  ~ObjectPool(){
+    for(unsigned int i=0; i<m_objects.size(); ++i) delete m_objects[i];
+  }
+
+  /// Object for the current event
+  T* Acquire(){
+    if(m_used==m_objects.size()) m_objects.push_back(new T());
+    return m_objects[m_used++];
+  }
+
+  /// Copy of object for the current event
+  T* Copy(const T& object){
+    T* copy = Acquire();
+    *copy = object;
+    return copy;
+  }
+
+  /// Give all objects back to the pool
+  void Reset(){ m_used = 0; }
+
+  /// Number of objects owned by the pool
+  unsigned int Capacity() const { return m_objects.size(); }
+
+private:
+  ObjectPool(const ObjectPool&);
+  ObjectPool& operator=(const ObjectPool&);
+
+  std::vector<T*> m_objects;
+  unsigned int m_used;
+
+}; // class ObjectPool
+
+/**
+ *  @short Owner of the transient objects of one event
+ *
+ *  Holds the Cleaner of the current event, a member re-initialised by
+ *  NewCleaner() for every event, and a pool for temporary top jet
+ *  collections. Call Reset() at the beginning of ExecuteEvent (skipped
+ *  events leave with an exception) and in EndInputData; it returns all
+ *  pooled objects without freeing memory, so the memory used by a job
+ *  does not grow with the number of events.
+ */
+
+class EventArena {
+
+public:
+  /// Default constructor
+  EventArena();
+  /// Default destructor
+  ~EventArena();
+
+  /// Cleaner for the current event working on the BaseCycleContainer of the EventCalc
+  Cleaner* NewCleaner();
+  /// Cleaner for the current event working on bcc
+  Cleaner* NewCleaner(BaseCycleContainer* bcc);
+
+  /// Pool for temporary top jet collections
+  ObjectPool<std::vector<TopJet> >& TopJetCollections() { return m_topjet_collections; }
+
+  /// Release all objects of the current event
+  void Reset();
+
+private:
+  EventArena(const EventArena&);
+  EventArena& operator=(const EventArena&);
+
+  Cleaner m_cleaner;
+
+  ObjectPool<std::vector<TopJet> > m_topjet_collections;
+
+}; // class EventArena
+
+#endif // EventArena_H
@@ -0,0 +1,50 @@
+// Dear emacs, this is -*- c++ -*-
+#ifndef EventContext_H
+#define EventContext_H
+
+// Local include(s):
+#include "include/SortedViewCache.h"
+#include "include/JetSoA.h"
+
+/**
+ *  @short State of the per-event helpers of this package
+ *
+ *  The sorted views and jet arrays built once per event for the event of
+ *  EventCalc::Instance() and shared by the histogram classes, in one
+ *  object of the process. The cycles invalidate them after cleaning the
+ *  jets in place and clear them in EndInputData, so no view outlives the
+ *  collections of its InputData.
+ *
+ *  Usage:
+ *    const IndexView<TopJet>& cajets = EventContext::Instance()->Views().Get(calc->GetCAJets());
+ */
+
+class EventContext {
+
+public:
+  /// Instance of the process
+  static EventContext* Instance();
+
+  /// Sorted views on the jet collections of the event
+  SortedViewCache& Views() { return m_views; }
+  /// Arrays of the jets and top jets of the event
+  JetSoA& Jets() { return m_jets; }
+  JetSoA& TopJets() { return m_topjets; }
+
+  /// Rebuild the cached views on their next use, call after a cleaner changed the collections
+  void Invalidate();
+  /// Forget all cached views, in EndInputData
+  void Clear();
+
+private:
+  EventContext() {}
+  EventContext(const EventContext&);
+  EventContext& operator=(const EventContext&);
+
+  SortedViewCache m_views;
+  JetSoA m_jets;
+  JetSoA m_topjets;
+
+}; // class EventContext
+
+#endif // EventContext_H
@@ -0,0 +1,105 @@
+// Dear emacs, this is -*- c++ -*-
+#ifndef EventIndex_H
+#define EventIndex_H
+
+#include <string>
+#include <vector>
+#include <set>
+
+// ROOT include(s):
+#include <TTree.h>
+
+// SFrame include(s):
+#include "core/include/SLogger.h"
+
+/**
+ *  @short Sorted run:lumi:event index of the entries of one skim file
+ *
+ *  Build() reads only the run, luminosityBlock and event branches of a
+ *  tree once; the index is saved next to other indices in a directory
+ *  (one file per skim file, named after its full path) and loaded from
+ *  there by later jobs. Find() is a binary search, so picking a few
+ *  events out of a file costs one lookup and one read per event.
+ *
+ *  The saved index records the number of entries of the tree and the
+ *  UUID of its file. Load() rejects an index of a file regenerated under
+ *  the same name, so the cycle builds and saves it again.
+ *
+ *  SkipAll() switches off all branches of the tree but the event number,
+ *  so the framework reads only that branch for every entry and its entry
+ *  tells which entry is processed. ReadEntry() then reads the branches
+ *  switched off by SkipAll() for a listed entry, except those switched off
+ *  by the cycle in the meantime (e.g. by a BranchUsageTracker).
+ *
+ *  Usage in a cycle processing only the events of a list:
+ *    BeginInputFile: index.Load(dir, file, tree) or index.Build(tree) and Save(),
+ *                    entries = index.Find(...) for all listed events,
+ *                    index.SkipAll(tree)
+ *    ExecuteEvent:   skip entries not listed, index.ReadEntry(entry, ...)
+ */
+
+class EventIndex {
+
+public:
+  /// One entry of the skim
+  struct Record {
+    Int_t run;
+    Int_t lumi;
+    Int_t event;
+    Long64_t entry;
+    bool operator<(const Record& other) const {
+      if(run!=other.run) return run<other.run;
+      if(lumi!=other.lumi) return lumi<other.lumi;
+      return event<other.event;
+    }
+  };
+
+  /// Named constructor
+  EventIndex(const char* name = "EventIndex");
+  /// Default destructor
+  ~EventIndex();
+
+  /// Index all entries of tree
+  bool Build(TTree* tree);
+  /// Save the index of file in directory
+  bool Save(const std::string& directory, const std::string& file) const;
+  /// Load the index of file from directory, false if there is none or it was built for another version of tree
+  bool Load(const std::string& directory, const std::string& file, TTree* tree);
+
+  /// Entry of the event, -1 if it is not in the file
+  Long64_t Find(int run, int lumi, int event) const;
+
+  /// Number of indexed entries
+  unsigned int Size() const { return m_records.size(); }
+
+  /// Switch off all branches of tree read until now but the event number
+  bool SkipAll(TTree* tree);
+  /// Entry of the tree loaded last by the framework, -1 before the first one
+  Long64_t CurrentEntry() const;
+  /// Read the branches switched off by SkipAll() for entry, except the ones named in skip
+  bool ReadEntry(Long64_t entry, const std::set<std::string>& skip);
+
+  /// Read (true) or skip (false) all branches of tree in TTree::GetEntry(entry)
+  static void SetProcess(TTree* tree, bool process);
+  /// Name of the index file of file in directory
+  static std::string IndexFile(const std::string& directory, const std::string& file);
+
+private:
+  /// UUID of the file of tree
+  static std::string FileUUID(TTree* tree);
+
+  std::vector<Record> m_records;
+  // entries and file UUID of the indexed tree
+  Long64_t m_nentries;
+  std::string m_uuid;
+
+  // event number branch, read for every entry
+  TBranch* m_reference;
+  // branches switched off by SkipAll()
+  std::vector<TBranch*> m_skipped;
+
+  mutable SLogger m_logger;
+
+}; // class EventIndex
+
+#endif // EventIndex_H
@@ -0,0 +1,85 @@
+// Dear emacs, this is -*- c++ -*-
+#ifndef EventListWriter_H
+#define EventListWriter_H
+
+#include <string>
+#include <vector>
+#include <cstdio>
+
+// ROOT include(s):
+#include <Rtypes.h>
+
+// SFrame include(s):
+#include "core/include/SLogger.h"
+
+/**
+ *  @short Buffered list of selected events, written per worker
+ *
+ *  Each process (every PROOF worker, or the single process of a local
+ *  job) writes its records to its own part file <basename>.part<N>.bin,
+ *  in blocks of binary (run, lumi, event, category bitmask) records,
+ *  so workers never share a file and do not flush per event. Merge(),
+ *  called on the master after all workers finished (EndMasterInputData),
+ *  sorts the records of all parts by run, lumi and event, writes
+ *  <basename>.bin and the text list <basename>.txt (run:lumi:event per
+ *  line) and removes the part files.
+ *
+ *  Under PROOF, basename must be in a directory shared by the workers
+ *  and the master.
+ */
+
+class EventListWriter {
+
+public:
+  /// One selected event
+  struct Record {
+    Int_t run;
+    Int_t lumi;
+    Int_t event;
+    UInt_t categories;
+    bool operator<(const Record& other) const {
+      if(run!=other.run) return run<other.run;
+      if(lumi!=other.lumi) return lumi<other.lumi;
+      return event<other.event;
+    }
+  };
+
+  /// Named constructor
+  EventListWriter(const char* name = "EventListWriter");
+  /// Default destructor, writes the buffered records
+  ~EventListWriter();
+
+  /// Start the part file of this process for basename
+  bool Open(const std::string& basename);
+  /// Add an event with the bitmask of the categories it was selected in
+  void Add(int run, int lumi, int event, UInt_t categories = 0);
+  /// Write the buffered records and close the part file
+  void Close();
+
+  /// Merge the part files of all processes for basename, call on the master
+  bool Merge(const std::string& basename);
+  /// Remove part files left from an earlier job, call on the master before processing
+  void RemoveParts(const std::string& basename);
+
+  /// Identifier of this process: the PROOF ordinal of the worker, 0 outside PROOF
+  static std::string ProcessId();
+  /// Part file of basename written by this process: <basename>.part<N><suffix>
+  static std::string PartFile(const std::string& basename, const std::string& suffix = ".bin");
+  /// Part files of basename written by all processes
+  static std::vector<std::string> PartFiles(const std::string& basename, const std::string& suffix = ".bin");
+
+private:
+  EventListWriter(const EventListWriter&);
+  EventListWriter& operator=(const EventListWriter&);
+
+  void Flush();
+
+  FILE* m_file;
+  std::vector<Record> m_buffer;
+  unsigned long m_nevents;
+
+  mutable SLogger m_logger;
+
+}; // class EventListWriter
+
+#endif // EventListWriter_H
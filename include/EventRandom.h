@@ -0,0 +1,82 @@
+// Dear emacs, this is -*- c++ -*-
+#ifndef EventRandom_H
+#define EventRandom_H
+
+#include <string>
+
+// ROOT include(s):
+#include <Rtypes.h>
+#include <TRandom3.h>
+
+// SFrame include(s):
+#include "include/BaseCycleContainer.h"
+
+/**
+ *  @short Random numbers depending only on the event, not on the order of processing
+ *
+ *  The random run number of MC events (LuminosityHandler::GetRandomRunNr)
+ *  and the jet energy resolution smearing of the Cleaner draw from
+ *  gRandom, so their values depend on the events processed before in the
+ *  same process, i.e. on the number of PROOF workers and the packets they
+ *  got. SeedEvent(), called at the beginning of ExecuteEvent, before any
+ *  random number of the event is drawn, seeds gRandom from the sample,
+ *  run, luminosity block and event number and a stream number: every event
+ *  gets the same random numbers in every job, and all passes over a
+ *  sample (systematic variations) the same ones for the same event.
+ *
+ *  The seeding is switched on with the property DeterministicRandom of
+ *  the cycle (default off), declared by DeclareProperties(); without it
+ *  SeedEvent() leaves gRandom alone.
+ *
+ *  A cycle cleaning the same event several times (one pass per channel)
+ *  calls SaveState() once before the first pass and RestoreState() before
+ *  every pass, so every pass draws the JER smearing a single cycle would
+ *  draw for the event. The state is kept for gRandom of type TRandom3,
+ *  the ROOT default.
+ *
+ *  Usage in a cycle, which declares EventRandom a friend:
+ *    constructor:    m_event_random->DeclareProperties(*this)
+ *    BeginInputData: SetSample(id.GetVersion().Data())
+ *    ExecuteEvent:   SeedEvent(bcc) before AnalysisCycle::ExecuteEvent
+ */
+
+class EventRandom {
+
+public:
+  /// Default constructor
+  EventRandom();
+  /// Default destructor
+  ~EventRandom();
+
+  /// Declare the property DeterministicRandom of the cycle
+  template<class Cycle> void DeclareProperties(Cycle& cycle) {
+    m_enabled = false;
+    cycle.DeclareProperty("DeterministicRandom", m_enabled);
+  }
+
+  /// Sample of the events, part of all seeds
+  void SetSample(const std::string& sample);
+
+  /// Seed of the stream of an event
+  ULong64_t Seed(int run, int lumi, int event, UInt_t stream) const;
+  /// Seed gRandom for the event in bcc, if DeterministicRandom is switched on
+  void SeedEvent(const BaseCycleContainer* bcc, UInt_t stream = 0) const;
+
+  /// Save the state of gRandom
+  void SaveState();
+  /// Set gRandom to the state saved last
+  void RestoreState() const;
+
+private:
+  /// Bijective 64 bit mixing function (finalizer of SplitMix64)
+  static ULong64_t Mix(ULong64_t x);
+
+  bool m_enabled;
+  ULong64_t m_sample;
+
+  TRandom3 m_state;
+  bool m_saved;
+
+}; // class EventRandom
+
+#endif // EventRandom_H
@@ -0,0 +1,200 @@
+// Dear emacs, this is -*- c++ -*-
+#ifndef FlatEventCache_H
+#define FlatEventCache_H
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <typeinfo>
+
+// ROOT include(s):
+#include <TTree.h>
+#include <TBranch.h>
+#include <TClass.h>
+
+// SFrame include(s):
+#include "core/include/SLogger.h"
+
+/**
+ *  @short Memory-mapped flat copy of the input collections of a skim file
+ *
+ *  The post-selection is run over the same skim for every systematic
+ *  variation and PDF member. On the first pass the collections registered
+ *  with AddCollection()/AddObject() are written per entry as raw arrays of
+ *  objects to <directory>/<file>.flatcache, before any correction is
+ *  applied to them. Later passes map that file and copy the arrays into the
+ *  BaseCycleContainer; the branches of these collections are switched off,
+ *  so ROOT reads and streams only the remaining branches.
+ *
+ *  Only classes without virtual functions, pointers or containers can be
+ *  stored as raw bytes (checked with their dictionary); other collections,
+ *  e.g. top jets with their subjets, are read from the tree as before. The
+ *  file records the size and checksum of every class, the number of
+ *  entries of the tree and the UUID and size of the input file, so a
+ *  cache of a skim regenerated under the same name is written again.
+ *  PROOF workers process only some entries of a file, so the cache is
+ *  written by local jobs only and read by both. Entries missing in the
+ *  cache are read from the tree.
+ *
+ *  Usage in a cycle:
+ *    BeginInputData: AddCollection("jets", bcc->jets), ... once
+ *    BeginInputFile: Open(directory, file, tree) after connecting the variables
+ *    ExecuteEvent:   Load() before AnalysisCycle::ExecuteEvent
+ *    EndInputData:   Close()
+ */
+
+class FlatEventCache {
+
+public:
+  /// Named constructor
+  FlatEventCache(const char* name = "FlatEventCache");
+  /// Default destructor, closes the cache
+  ~FlatEventCache();
+
+  /// Cache the collection connected to member (e.g. bcc->jets)
+  template<class T> void AddCollection(const char* name, std::vector<T>*& member) {
+    m_columns.push_back(new VectorColumn<T>(name, member));
+  }
+  /// Cache the single object connected to member (e.g. bcc->met)
+  template<class T> void AddObject(const char* name, T*& member) {
+    m_columns.push_back(new ObjectColumn<T>(name, member));
+  }
+
+  /// Read the cache of file in directory, or start writing it if there is none; call after connecting the variables
+  bool Open(const std::string& directory, const std::string& file, TTree* tree);
+  /// Write (first pass) or fill (later passes) the cached collections of the current entry
+  void Load();
+  /// Finish writing the cache, release the mapped file
+  void Close();
+
+  /// Number of registered collections
+  unsigned int NColumns() const { return m_columns.size(); }
+  bool IsWriting() const { return m_out!=0; }
+  bool IsReading() const { return m_data!=0; }
+
+  /// Name of the cache file of file in directory
+  static std::string CacheFile(const std::string& directory, const std::string& file);
+  /// True if objects of the class can be copied as raw bytes
+  static bool IsFlat(TClass* cl);
+
+private:
+  /// One cached collection, stored as the number of objects and their bytes
+  class Column {
+  public:
+    Column(const char* name) : m_name(name), m_branch(0) {}
+    virtual ~Column() {}
+    virtual const void* Address() const = 0;
+    virtual TClass* Class() const = 0;
+    virtual UInt_t ObjectSize() const = 0;
+    virtual void Write(FILE* out) const = 0;
+    virtual const char* Read(const char* data) = 0;
+    const std::string& Name() const { return m_name; }
+    TBranch* Branch() const { return m_branch; }
+    void SetBranch(TBranch* branch) { m_branch = branch; }
+  private:
+    std::string m_name;
+    TBranch* m_branch;
+  };
+
+  template<class T> class VectorColumn : public Column {
+  public:
+    VectorColumn(const char* name, std::vector<T>*& member) : Column(name), m_member(member) {}
+    const void* Address() const { return &m_member; }
+    TClass* Class() const { return TClass::GetClass(typeid(T)); }
+    UInt_t ObjectSize() const { return sizeof(T); }
+    void Write(FILE* out) const {
+      UInt_t n = m_member ? m_member->size() : 0;
+      fwrite(&n, sizeof(UInt_t), 1, out);
+      if(n) fwrite(&(*m_member)[0], sizeof(T), n, out);
+    }
+    const char* Read(const char* data) {
+      UInt_t n;
+      memcpy(&n, data, sizeof(UInt_t));
+      data += sizeof(UInt_t);
+      m_member->resize(n);
+      if(n) memcpy(&(*m_member)[0], data, n*sizeof(T));
+      return data + n*sizeof(T);
+    }
+  private:
+    std::vector<T>*& m_member;
+  };
+
+  template<class T> class ObjectColumn : public Column {
+  public:
+    ObjectColumn(const char* name, T*& member) : Column(name), m_member(member) {}
+    const void* Address() const { return &m_member; }
+    TClass* Class() const { return TClass::GetClass(typeid(T)); }
+    UInt_t ObjectSize() const { return sizeof(T); }
+    void Write(FILE* out) const {
+      UInt_t n = m_member ? 1 : 0;
+      fwrite(&n, sizeof(UInt_t), 1, out);
+      if(n) fwrite(m_member, sizeof(T), 1, out);
+    }
+    const char* Read(const char* data) {
+      UInt_t n;
+      memcpy(&n, data, sizeof(UInt_t));
+      data += sizeof(UInt_t);
+      if(n && m_member) memcpy(m_member, data, sizeof(T));
+      return data + n*sizeof(T);
+    }
+  private:
+    T*& m_member;
+  };
+
+  struct Header {
+    char magic[4];
+    UInt_t version;
+    UInt_t ncolumns;
+    UInt_t reserved;
+    Long64_t nentries;
+    Long64_t table;
+    // identity of the input file
+    Long64_t filesize;
+    char uuid[40];
+  };
+
+  struct Descriptor {
+    char name[32];
+    UInt_t size;
+    UInt_t checksum;
+  };
+
+  void SetProcess(TBranch* branch, bool process);
+  void FillDescriptor(const Column* column, Descriptor& descriptor) const;
+  void FillHeader(Header& header, Long64_t nentries, Long64_t table) const;
+  bool OpenForReading(TTree* tree);
+  bool OpenForWriting(TTree* tree);
+  void ReadFromTree(Long64_t entry);
+
+  std::vector<Column*> m_columns;
+  // columns connected to a branch and stored as raw bytes
+  std::vector<Column*> m_active;
+
+  TTree* m_tree;
+  // branch read for every entry, gives the current entry
+  TBranch* m_reference;
+  std::string m_filename;
+  std::string m_tmpname;
+  // identity of the input file
+  std::string m_file_uuid;
+  Long64_t m_file_size;
+
+  // writing
+  FILE* m_out;
+  std::vector<Long64_t> m_offsets;
+
+  // reading
+  char* m_data;
+  size_t m_size;
+  const Long64_t* m_table;
+  Long64_t m_nentries;
+
+  unsigned long m_ncached;
+  unsigned long m_nmissing;
+
+  mutable SLogger m_logger;
+
+}; // class FlatEventCache
+
+#endif // FlatEventCache_H
@@ -8,6 +8,7 @@
 #include "include/SelectionModules.h"
 #include "include/GenTTbarHists.h"
 #include "include/HypothesisHists.h"
+#include "include/BranchUsageTracker.h"
 
 class GenTTbarCycle : public AnalysisCycle {
 
@@ -38,6 +39,15 @@ private:
   // Put all your private variables here
   //
 
+  int m_branch_usage_learn_events;
+  std::string m_branch_usage_keep;
+  BranchUsageTracker* m_branch_usage;
+
+  bool m_histogram_only;
+
+  // selections used in ExecuteEvent, set in BeginInputData
+  Selection* m_mtt_selection;
+
   // Macro adding the functions for dictionary generation
   ClassDef( GenTTbarCycle, 0 );
 
@@ -0,0 +1,29 @@
+// Dear emacs, this is -*- c++ -*-
+#ifndef HistogramOnlyMode_H
+#define HistogramOnlyMode_H
+
+// SFrame include(s):
+#include "core/include/SInputData.h"
+#include "core/include/SError.h"
+
+/**
+ *  @short Declared histogram-only execution of a cycle
+ *
+ *  Cycles producing only histograms set the HistogramOnly property. The
+ *  output trees are created by SFrame for every <OutputTree> of the
+ *  InputData, and AnalysisCycle declares its output variables on them,
+ *  filled with WriteOutputTree() and merged by PROOF even if empty.
+ *  Check(), called before AnalysisCycle::BeginInputData, stops the job
+ *  if such a tree is configured, so nothing but histograms is allocated,
+ *  filled and merged; the cycle skips WriteOutputTree() in this mode.
+ */
+
+class HistogramOnlyMode {
+
+public:
+  /// Stop the job if an output tree is configured for the InputData
+  static void Check( const SInputData& id ) throw( SError );
+
+}; // class HistogramOnlyMode
+
+#endif // HistogramOnlyMode_H
@@ -0,0 +1,87 @@
+// Dear emacs, this is -*- c++ -*-
+#ifndef IndexView_H
+#define IndexView_H
+
+#include <vector>
+#include <algorithm>
+
+/**
+ *  @short Filtered and ordered view on a collection
+ *
+ *  The view stores indices into the underlying collection, so filtering
+ *  and sorting only move integers and never copy the objects (TopJets
+ *  carry their subjets). Consumers can read the selected objects through
+ *  the view; framework code expecting a collection gets it with one copy
+ *  per selected object from Materialize().
+ *
+ *  Usage:
+ *    IndexView<TopJet> view(bcc->topjets);
+ *    view.Filter(MyCut()).Sort(HigherPt());
+ *    for(unsigned int i=0; i<view.size(); ++i) view[i].pt();
+ */
+
+template<typename T>
+class IndexView {
+
+public:
+  IndexView(): m_collection(0) {}
+  explicit IndexView(const std::vector<T>* collection){ Reset(collection); }
+
+  /// View on all objects of collection in their original order
+  void Reset(const std::vector<T>* collection){
+    m_collection = collection;
+    m_indices.clear();
+    if(!collection) return;
+    m_indices.reserve(collection->size());
+    for(unsigned int i=0; i<collection->size(); ++i) m_indices.push_back(i);
+  }
+
+  /// Keep only the objects for which pred(object) is true
+  template<typename Pred>
+  IndexView& Filter(Pred pred){
+    unsigned int n=0;
+    for(unsigned int i=0; i<m_indices.size(); ++i){
+      if(pred(m_collection->at(m_indices[i]))) m_indices[n++] = m_indices[i];
+    }
+    m_indices.resize(n);
+    return *this;
+  }
+
+  /// Order the objects by less(object1, object2), equal objects keep their order
+  template<typename Less>
+  IndexView& Sort(Less less){
+    std::stable_sort(m_indices.begin(), m_indices.end(), IndexLess<Less>(m_collection, less));
+    return *this;
+  }
+
+  unsigned int size() const { return m_indices.size(); }
+  bool empty() const { return m_indices.empty(); }
+
+  const T& operator[](unsigned int i) const { return (*m_collection)[m_indices[i]]; }
+  const T& at(unsigned int i) const { return m_collection->at(m_indices.at(i)); }
+
+  /// Index of the i-th object of the view in the underlying collection
+  unsigned int index(unsigned int i) const { return m_indices[i]; }
+
+  /// Copy the objects of the view in view order to out
+  void Materialize(std::vector<T>& out) const {
+    out.clear();
+    out.reserve(m_indices.size());
+    for(unsigned int i=0; i<m_indices.size(); ++i) out.push_back((*m_collection)[m_indices[i]]);
+  }
+
+private:
+  template<typename Less>
+  struct IndexLess {
+    const std::vector<T>* collection;
+    Less less;
+    IndexLess(const std::vector<T>* c, Less l): collection(c), less(l) {}
+    bool operator()(unsigned int a, unsigned int b){ return less((*collection)[a], (*collection)[b]); }
+  };
+
+  const std::vector<T>* m_collection;
+  std::vector<unsigned int> m_indices;
+
+}; // class IndexView
+
+#endif // IndexView_H
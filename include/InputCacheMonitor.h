@@ -0,0 +1,86 @@
+// Dear emacs, this is -*- c++ -*-
+#ifndef InputCacheMonitor_H
+#define InputCacheMonitor_H
+
+// ROOT include(s):
+#include <TTree.h>
+
+// SFrame include(s):
+#include "core/include/SLogger.h"
+
+/**
+ *  @short TTreeCache and prefetching of the input tree, with read statistics
+ *
+ *  The cache size in bytes (InputCacheSize), the number of entries of
+ *  the learning phase (InputCacheLearnEntries, default 100) and
+ *  asynchronous prefetching (InputAsyncPrefetch) are properties of the
+ *  cycle, declared by DeclareProperties() in its constructor; the cycle
+ *  declares InputCacheMonitor a friend. Configure() in BeginInputData
+ *  applies them (prefetching must be enabled before the input files are
+ *  opened) and resets the statistics. Setup() in
+ *  BeginInputFile attaches the cache to the tree of the new file; during
+ *  the learning phase the cache records the branches the cycle reads,
+ *  so branches switched off or only read for few events are not
+ *  prefetched. With a cache size of 0 the cache configured for the
+ *  cycle in the XML (UseTreeCache) is left untouched and only monitored.
+ *
+ *  Update() in ExecuteEvent samples the cache of the current file,
+ *  PrintStatistics() in EndInputData reports the bytes and read calls of
+ *  the InputData and the fraction of reads served by the cache.
+ */
+
+class InputCacheMonitor {
+
+public:
+  /// Named constructor
+  InputCacheMonitor(const char* name = "InputCacheMonitor");
+  /// Default destructor
+  ~InputCacheMonitor();
+
+  /// Declare the properties InputCacheSize, InputCacheLearnEntries and InputAsyncPrefetch of the cycle
+  template<class Cycle> void DeclareProperties(Cycle& cycle) {
+    cycle.DeclareProperty("InputCacheSize", m_cachesize);
+    cycle.DeclareProperty("InputCacheLearnEntries", m_learnentries);
+    cycle.DeclareProperty("InputAsyncPrefetch", m_asyncprefetch);
+  }
+
+  /// Apply the properties and reset the statistics, in BeginInputData
+  void Configure();
+
+  /// Attach the cache to the tree of a new input file
+  void Setup(TTree* tree);
+
+  /// Sample the cache statistics of the current file
+  void Update();
+
+  /// Print the statistics of the InputData
+  void PrintStatistics();
+
+private:
+  void CommitFile();
+
+  TTree* m_tree;
+  // properties (int, double, bool or string for SFrame), cache size in bytes (0: not changed)
+  int m_cachesize;
+  int m_learnentries;
+  bool m_asyncprefetch;
+
+  Long64_t m_bytes_start;
+  Int_t m_calls_start;
+
+  unsigned long m_nfiles;
+  unsigned long m_nevents;
+  unsigned long m_file_events;
+  unsigned long m_cached_events;
+
+  // cache efficiencies of the current file and their sums weighted with the number of events
+  double m_efficiency;
+  double m_efficiency_rel;
+  double m_sum_efficiency;
+  double m_sum_efficiency_rel;
+
+  mutable SLogger m_logger;
+
+}; // class InputCacheMonitor
+
+#endif // InputCacheMonitor_H
@@ -10,6 +10,8 @@
 #include "include/JetLeptonCleanerHists.h"
 #include "include/EventCalc.h"
 #include "JetCorrectorParameters.h"
+#include "include/CollectionCheckpoint.h"
+#include "include/EventRandom.h"
 
 /**
  *  @short Cycle to study the jet-lepton cleaner
@@ -47,6 +49,15 @@ private:
   // Put all your private variables here
   //
 
+  // uncleaned jets and MET for the second step with lepton cuts
+  CollectionCheckpoint<Jet>* m_jets_checkpoint;
+  ObjectCheckpoint<MET>* m_met_checkpoint;
+
+  // declares the property DeterministicRandom
+  friend class EventRandom;
+  // the histograms smear the jet energies
+  EventRandom* m_event_random;
+
   // Macro adding the functions for dictionary generation
   ClassDef( JetLeptonCleanerCycle, 0 );
 
@@ -9,9 +9,11 @@
 #include "include/BaseHists.h"
 #include "include/BaseCycleContainer.h"
 #include "include/Cleaner.h"
+#include "include/EventArena.h"
 #include "FactorizedJetCorrector.h"
 #include "JetCorrectorParameters.h"
 #include "TH2.h"
+#include "include/CollectionCheckpoint.h"
 
 /**
  *   @short histogram class for the JetLeptonCleanerCycle
@@ -35,6 +37,8 @@ public:
 private:
 
    FactorizedJetCorrector* m_corrector;
+   CollectionCheckpoint<Jet> m_jets_checkpoint;
+   EventArena m_arena;
 
 
 }; // class JetLeptonCleanerHists
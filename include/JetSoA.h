@@ -0,0 +1,91 @@
+// Dear emacs, this is -*- c++ -*-
+#ifndef JetSoA_H
+#define JetSoA_H
+
+#include <vector>
+
+// SFrame include(s):
+#include "include/BaseCycleContainer.h"
+
+/**
+ *  @short Structure-of-arrays view on a jet collection
+ *
+ *  Kinematics, b-tag discriminator and flags of all jets are stored in
+ *  contiguous float arrays, so scans over the jets (nearest jet, HT,
+ *  number of b-tags) run over plain arrays instead of calling the
+ *  accessors of every Jet or TopJet. The Particle members are floats,
+ *  the arrays hold exact copies and distances are computed in double
+ *  precision as in Particle::deltaR.
+ *
+ *  The views are built lazily once per event by Jets() and TopJets()
+ *  and rebuilt for another collection (address or size) and after
+ *  Invalidate(), called through EventContext::Invalidate() once a
+ *  cleaner changed the jets in place. The views are owned by the
+ *  EventContext.
+ */
+
+class JetSoA {
+
+public:
+  enum E_Flags { e_GenJet = 1 };
+
+  JetSoA();
+
+  /// View on jets for the current event
+  static const JetSoA& Jets(const std::vector<Jet>* jets);
+  /// View on top jets for the current event
+  static const JetSoA& TopJets(const std::vector<TopJet>* topjets);
+
+  /// Fill the arrays again on the next Jets() or TopJets()
+  void Invalidate() { m_collection = 0; }
+
+  /// Fill the arrays from a collection
+  void Fill(const std::vector<Jet>* jets);
+  void Fill(const std::vector<TopJet>* topjets);
+
+  unsigned int size() const { return m_pt.size(); }
+
+  const float* pt() const { return m_pt.empty() ? 0 : &m_pt[0]; }
+  const float* eta() const { return m_eta.empty() ? 0 : &m_eta[0]; }
+  const float* phi() const { return m_phi.empty() ? 0 : &m_phi[0]; }
+  const float* energy() const { return m_energy.empty() ? 0 : &m_energy[0]; }
+  const float* csv() const { return m_csv.empty() ? 0 : &m_csv[0]; }
+  const int* flags() const { return m_flags.empty() ? 0 : &m_flags[0]; }
+
+  /// Delta phi between jet i and p, as Particle::deltaPhi
+  double DeltaPhi(unsigned int i, const Particle& p) const;
+  /// Delta R between jet i and p, as Particle::deltaR
+  double DeltaR(unsigned int i, const Particle& p) const;
+
+  /// Index of the jet closest to p in delta R, skipping jets with the pT of p (as nextJet); -1 if none
+  int NearestIndex(const Particle& p) const;
+
+  /// Scalar sum of the jet pT above ptmin
+  double HT(double ptmin=0) const;
+
+  /// Number of jets with a CSV discriminator above cut
+  int NBTags(float cut) const;
+
+private:
+  template<typename T>
+  void FillFrom(const std::vector<T>* collection);
+
+  template<typename T>
+  bool Matches(const std::vector<T>* collection) const;
+
+  std::vector<float> m_pt;
+  std::vector<float> m_eta;
+  std::vector<float> m_phi;
+  std::vector<float> m_energy;
+  std::vector<float> m_csv;
+  std::vector<int> m_flags;
+
+  // identity of the collection the arrays were filled from
+  const void* m_collection;
+  const void* m_data;
+  int m_run;
+  int m_event;
+
+}; // class JetSoA
+
+#endif // JetSoA_H
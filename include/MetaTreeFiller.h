@@ -10,6 +10,7 @@
 // Local include(s):
 #include "include/BaseHists.h"
 #include "include/BaseCycleContainer.h"
+#include "include/TreeWriter.h"
 
 /**
  *   class for booking and filling histograms to discriminate 
@@ -24,7 +25,7 @@ class MetaTreeFiller : public BaseHists {
 
 public:
    /// Named constructor
-  MetaTreeFiller(const char* name, HypothesisDiscriminator *discr, TTree* MetaOutputTree);
+  MetaTreeFiller(const char* name, HypothesisDiscriminator *discr, TreeWriter* writer);
 
    /// Default destructor
    ~MetaTreeFiller();
@@ -36,30 +37,30 @@ public:
    void Finish();
 
 private:
-   TTree* m_tree;
+   TreeWriter* m_writer; //!
    
-   Double_t m_weight;
-   Double_t m_pT_mu;
-   Double_t m_HT; 
-   Double_t m_2D; 
-   Double_t m_mtt;
-   Double_t m_met_pt; 
-   Double_t m_Jet_pt_max;
-   Double_t m_btag;
-
-   Double_t m_Iso05; 
-   Double_t m_Iso04; 
-
-   Double_t m_Iso02;
-   Double_t m_Iso018;
-   Double_t m_Iso016;
-   Double_t m_Iso014;
-   Double_t m_Iso012;
-   Double_t m_Iso01; 
-   Double_t m_Iso008;
-   Double_t m_Iso006;
-   Double_t m_Iso004;
-   Double_t m_Iso002;
+   Float_t* m_weight; //!
+   Float_t* m_pT_mu; //!
+   Float_t* m_HT; //!
+   Bool_t* m_2D; //!
+   Float_t* m_mtt; //!
+   Float_t* m_met_pt; //!
+   Float_t* m_Jet_pt_max; //!
+   Int_t* m_btag; //!
+
+   Float_t* m_Iso05; //!
+   Float_t* m_Iso04; //!
+
+   Float_t* m_Iso02; //!
+   Float_t* m_Iso018; //!
+   Float_t* m_Iso016; //!
+   Float_t* m_Iso014; //!
+   Float_t* m_Iso012; //!
+   Float_t* m_Iso01; //!
+   Float_t* m_Iso008; //!
+   Float_t* m_Iso006; //!
+   Float_t* m_Iso004; //!
+   Float_t* m_Iso002; //!
 
 
    HypothesisDiscriminator* m_discr;
@@ -0,0 +1,69 @@
+// Dear emacs, this is -*- c++ -*-
+#ifndef OutputPolicy_H
+#define OutputPolicy_H
+
+#include <string>
+#include <map>
+
+// ROOT include(s):
+#include <TTree.h>
+
+// SFrame include(s):
+#include "core/include/SLogger.h"
+
+/**
+ *  @short Compression and precision settings for the output trees of a cycle
+ *
+ *  The compression is given as "ALGORITHM[:LEVEL]" with ALGORITHM one of
+ *  ZLIB, LZMA or LZ4 (ROOT 6.12 and later), e.g. "LZ4:4" for intermediate
+ *  skims and "LZMA:9" for archival. Apply() sets it for the output file of
+ *  a tree and all its branches; it only affects baskets written afterwards,
+ *  so call it in BeginInputData before the first event.
+ *
+ *  The precision is given as space-separated "column:bits" pairs, the
+ *  number of mantissa bits kept for Float_t columns written through a
+ *  TreeWriter ("*:bits" for all other columns; 10 bits correspond to
+ *  half precision, 23 keep the full value). Dropped bits are written as
+ *  zeros, which the compression removes. With PackFlags the Bool_t
+ *  columns of a TreeWriter are stored as bits of one UInt_t column.
+ */
+
+class OutputPolicy {
+
+public:
+  /// Named constructor
+  OutputPolicy(const char* name = "OutputPolicy");
+  /// Default destructor
+  ~OutputPolicy();
+
+  /// Set the compression, an empty setting keeps the ROOT default
+  bool SetCompression(const std::string& setting);
+  /// Set the mantissa bits of the Float_t columns
+  bool SetPrecision(const std::string& setting);
+  /// Store Bool_t columns as bits of one column
+  void SetPackFlags(bool pack) { m_pack_flags = pack; }
+
+  /// Apply the compression to the output file of tree and its branches
+  void Apply(TTree* tree);
+
+  /// Mantissa bits kept for column, -1 for full precision
+  int PrecisionBits(const std::string& column) const;
+  /// True if Bool_t columns are packed
+  bool PackFlags() const { return m_pack_flags; }
+
+  /// value rounded to bits mantissa bits
+  static Float_t Truncate(Float_t value, int bits);
+
+private:
+  void SetBranchCompression(TBranch* branch);
+
+  int m_compression;
+  std::map<std::string, int> m_precision;
+  int m_default_precision;
+  bool m_pack_flags;
+
+  mutable SLogger m_logger;
+
+}; // class OutputPolicy
+
+#endif // OutputPolicy_H
@@ -0,0 +1,131 @@
+// Dear emacs, this is -*- c++ -*-
+#ifndef PDFWeightColumns_H
+#define PDFWeightColumns_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+
+// ROOT include(s):
+#include <Rtypes.h>
+
+// SFrame include(s):
+#include "core/include/SLogger.h"
+
+/**
+ *  @short Compact per-event weights of all members of a PDF set
+ *
+ *  The file holds one record per event with the key (run, lumi, event)
+ *  followed by the weight ratios of all PDF members as half precision
+ *  floats (relative precision 2^-11). The records of the file read by
+ *  OpenForReading() are sorted by key. A job reading events in key order
+ *  finds each event in the next record and reads the file once
+ *  sequentially; any other event is found by a binary search, as in
+ *  EventIndex. Only the key of the first record of every block of
+ *  records is kept in memory, so a lookup reads at most one block.
+ *
+ *  Every process (PROOF worker, or the single process of a local job)
+ *  writes its events in processing order to its own part file
+ *  <basename>.part<N>.pdfw, see EventListWriter. Merge(), called on the
+ *  master after all workers finished (EndMasterInputData), sorts every
+ *  part and merges them into <basename>.pdfw. Under PROOF, basename must
+ *  be in a directory shared by the workers and the master.
+ *
+ *  File layout: "PDFW", format version, number of members, number of
+ *  records (all UInt_t), then the records of 3 Int_t and n UShort_t.
+ */
+
+class PDFWeightColumns {
+
+public:
+  /// Named constructor
+  PDFWeightColumns(const char* name = "PDFWeightColumns");
+  /// Default destructor, closes the file
+  ~PDFWeightColumns();
+
+  /// Create the part file of this process for basename, the number of members is taken from the first Fill()
+  bool OpenForWriting(const std::string& basename);
+  /// Append the weights of all members for the event
+  void Fill(int run, int lumi, int event, const std::vector<double>& weights);
+
+  /// Open filename for lookups
+  bool OpenForReading(const std::string& filename);
+  /// Weights of all members for the event, null if the event is not in the file
+  const std::vector<float>* Find(int run, int lumi, int event);
+
+  /// Finish writing or reading
+  void Close();
+
+  /// Merge the part files of all processes for basename into <basename>.pdfw sorted by key, call on the master
+  bool Merge(const std::string& basename);
+  /// Remove part files left from an earlier job, call on the master before processing
+  void RemoveParts(const std::string& basename);
+
+  /// True between opening and Close()
+  bool IsOpen() { return m_out.is_open() || m_in.is_open(); }
+
+  /// Number of PDF members per event
+  unsigned int NMembers() const { return m_nmembers; }
+
+  /// Print the number of events written or found
+  void PrintStatistics();
+
+  /// Conversion to IEEE 754 half precision, rounding to nearest even
+  static UShort_t ToHalf(float value);
+  /// Conversion from IEEE 754 half precision
+  static float FromHalf(UShort_t half);
+
+private:
+  struct Key {
+    Int_t run, lumi, event;
+    bool operator<(const Key& other) const {
+      if(run!=other.run) return run<other.run;
+      if(lumi!=other.lumi) return lumi<other.lumi;
+      return event<other.event;
+    }
+  };
+
+  // key and position of a record, for sorting
+  struct Position {
+    Key key;
+    UInt_t record;
+    bool operator<(const Position& other) const { return key<other.key; }
+  };
+
+  unsigned int RecordSize() const { return 3*sizeof(Int_t) + m_nmembers*sizeof(UShort_t); }
+  void WriteHeader();
+  const char* Record(UInt_t record);
+  void Decode(const char* record);
+  Key GetKey(const char* record) const;
+  void SortRecords(std::vector<char>& records) const;
+  void BuildIndex();
+
+  std::ofstream m_out;
+  std::ifstream m_in;
+
+  UInt_t m_nmembers;
+  UInt_t m_nrecords;
+  bool m_writing;
+
+  // block of records read from the file
+  std::vector<char> m_block;
+  UInt_t m_block_first;
+  UInt_t m_block_size;
+
+  UInt_t m_next;
+  bool m_indexed;
+  // key of the first record of every block
+  std::vector<Key> m_index;
+
+  std::vector<UShort_t> m_halfs;
+  std::vector<float> m_weights;
+
+  unsigned long m_nfound;
+  unsigned long m_nindexed;
+  unsigned long m_nmissing;
+
+  mutable SLogger m_logger;
+
+}; // class PDFWeightColumns
+
+#endif // PDFWeightColumns_H
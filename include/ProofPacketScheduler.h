@@ -0,0 +1,79 @@
+// Dear emacs, this is -*- c++ -*-
+#ifndef ProofPacketScheduler_H
+#define ProofPacketScheduler_H
+
+#include <string>
+
+// ROOT include(s):
+#include <TStopwatch.h>
+
+// SFrame include(s):
+#include "core/include/SLogger.h"
+
+/**
+ *  @short PROOF query parameters of an InputData and a report of its packets
+ *
+ *  Every InputData is processed by PROOF as a query of its own. PROOF's
+ *  default packetizer (TPacketizerAdaptive) splits the files of the query
+ *  into packets (entry ranges of one file) and hands them to the workers
+ *  asking for more work. SetParameters(), called on the master before
+ *  the query is started (BeginMasterInputData), only changes the packet
+ *  size of that packetizer: with a packet fraction N
+ *  (ProofPacketFraction, 0: PROOF default) a packet holds about 1/N of
+ *  the entries left per worker, so the packets get smaller towards the
+ *  end of the query and the workers finish close to each other.
+ *
+ *  The outputs of the workers are merged by the master one after the
+ *  other. With ProofMergers (0: number chosen by PROOF, default -1: only
+ *  the master) several workers merge the outputs of a group of workers
+ *  each, in parallel, after they finished their packets; the master then
+ *  only merges the results of the mergers.
+ *
+ *  These options are properties of the cycle, declared by
+ *  DeclareProperties() in its constructor; the cycle declares
+ *  ProofPacketScheduler a friend.
+ *
+ *  With the timing switched on (ProofPacketTiming), PROOF records every
+ *  packet (worker, file, entries, processing time); PrintSummary() in
+ *  EndMasterInputData reports the packets of the InputData, the
+ *  processing time per worker and the time the workers stayed idle before
+ *  the last one finished, and the wall time of the InputData including
+ *  the merging of the outputs. For local jobs only the wall time is
+ *  reported.
+ */
+
+class ProofPacketScheduler {
+
+public:
+  /// Named constructor
+  ProofPacketScheduler(const char* name = "ProofPacketScheduler");
+  /// Default destructor
+  ~ProofPacketScheduler();
+
+  /// Declare the properties ProofPacketFraction, ProofPacketTiming and ProofMergers of the cycle
+  template<class Cycle> void DeclareProperties(Cycle& cycle) {
+    cycle.DeclareProperty("ProofPacketFraction", m_packet_fraction);
+    cycle.DeclareProperty("ProofPacketTiming", m_timing);
+    cycle.DeclareProperty("ProofMergers", m_mergers);
+  }
+
+  /// Set the packetizer parameters of the PROOF session, on the master before the query
+  void SetParameters(const std::string& inputdata);
+
+  /// Print the packets and the worker times of the query, on the master after the query
+  void PrintSummary();
+
+private:
+  // properties
+  int m_packet_fraction;
+  bool m_timing;
+  int m_mergers;
+
+  std::string m_inputdata;
+  TStopwatch m_stopwatch;
+
+  mutable SLogger m_logger;
+
+}; // class ProofPacketScheduler
+
+#endif // ProofPacketScheduler_H
@@ -10,6 +10,9 @@
 #include "include/SelectionModules.h"
 #include "HypothesisStatistics.h"
 #include "Cleaner.h"
+#include "include/EventArena.h"
+#include "include/TreeWriter.h"
+#include "include/OutputPolicy.h"
 #include "JetCorrectionUncertainty.h"
 #include "FactorizedJetCorrector.h"
 #include "JetCorrectorParameters.h"
@@ -75,6 +78,12 @@ private:
 
 
   TTree* m_tree;
+  TreeWriter* m_treewriter;
+
+  std::string m_output_compression;
+  std::string m_output_precision;
+  bool m_output_packflags;
+  OutputPolicy* m_output_policy;
 
   Chi2Discriminator* m_chi2discr;
   Chi2Discriminator* m_tagchi2discr;
@@ -93,8 +102,25 @@ private:
   bool m_mttgencut;
 
   JetCorrectionUncertainty* m_jes_unc;
+  EventArena* m_arena;
   Cleaner* m_cleaner;
 
+  // selections used in ExecuteEvent, set in BeginInputData
+  Selection* m_BSel;
+  Selection* m_MuonSel;
+  Selection* m_NoBSel;
+  Selection* m_TopTagSel;
+  Selection* m_TwoDMuon;
+  Selection* m_HCALlaser;
+  Selection* m_ChiSelection;
+  Selection* m_ChiNoTag;
+  Selection* m_IsoSel;
+  Selection* m_PTSel;
+  Selection* m_METSel;
+  Selection* m_HTmuonSel;
+  Selection* m_NJetSel;
+  Selection* m_RazorSelection;
+
   // Macro adding the functions for dictionary generation
   ClassDef( QCDCycle, 0 );
 
@@ -0,0 +1,74 @@
+// Dear emacs, this is -*- c++ -*-
+#ifndef SkimBranchFilter_H
+#define SkimBranchFilter_H
+
+#include <string>
+#include <set>
+
+// ROOT include(s):
+#include <TTree.h>
+#include <TBranch.h>
+
+// SFrame include(s):
+#include "core/include/SLogger.h"
+
+/**
+ *  @short Restrict the output tree of a skim to the branches used downstream
+ *
+ *  The keep list holds branch names of the output tree (e.g.
+ *  "goodPatJetsPFlow"), or names of object fields of split branches
+ *  (e.g. "goodPatJetsPFlow.m_pt"). Apply() removes all other branches
+ *  from the tree; of a branch listed only with fields, the other fields
+ *  are not filled. Call it in BeginInputData, after the output branches
+ *  are declared and before the first event is written.
+ *
+ *  The list can be learned from a profiling run of the downstream cycle:
+ *  AddUsedBranches() collects the names of all branches of its input tree
+ *  which were read, after the reading of every event, since the read
+ *  state is lost with the tree of an input file. Every process writes
+ *  its names to a part file of its own (WriteUsedBranchesPart()), and
+ *  MergeUsedBranches() on the master writes the union of the parts in
+ *  the format read by ReadKeepFile().
+ */
+
+class SkimBranchFilter {
+
+public:
+  /// Named constructor
+  SkimBranchFilter(const char* name = "SkimBranchFilter");
+  /// Default destructor
+  ~SkimBranchFilter();
+
+  /// Keep all space-separated branches and fields
+  void AddKeep(const std::string& names);
+  /// Keep the branches and fields listed in filename, one per line, # starts a comment
+  bool ReadKeepFile(const std::string& filename);
+
+  /// True if nothing was declared, Apply() then keeps all branches
+  bool Empty() const { return m_keep.empty(); }
+
+  /// Remove the branches and switch off the fields not in the keep list
+  void Apply(TTree* tree);
+
+  /// Add the names of all branches and fields of tree read at least once to used
+  static void AddUsedBranches(TTree* tree, std::set<std::string>& used);
+  /// Write the names in used to the part file of this process for filename
+  static bool WriteUsedBranchesPart(const std::set<std::string>& used, const std::string& filename);
+  /// Write the union of the part files of all processes to filename and remove the parts, call on the master
+  static bool MergeUsedBranches(const std::string& filename);
+  /// Remove the part files of an earlier job for filename
+  static void RemoveUsedBranchesParts(const std::string& filename);
+
+private:
+  bool KeepField(TBranch* branch, const std::string& top) const;
+  void FilterFields(TBranch* branch, const std::string& top, int& ndisabled) const;
+  static void CollectUsed(TBranch* branch, std::set<std::string>& used);
+  static bool WriteBranchList(const std::set<std::string>& names, const std::string& filename);
+
+  std::set<std::string> m_keep;
+
+  mutable SLogger m_logger;
+
+}; // class SkimBranchFilter
+
+#endif // SkimBranchFilter_H
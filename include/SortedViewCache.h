@@ -0,0 +1,80 @@
+// Dear emacs, this is -*- c++ -*-
+#ifndef SortedViewCache_H
+#define SortedViewCache_H
+
+#include <vector>
+#include <deque>
+
+// SFrame include(s):
+#include "include/BaseCycleContainer.h"
+
+// Local include(s):
+#include "include/IndexView.h"
+
+/**
+ *  @short Per-event cache of ordered views on jet collections
+ *
+ *  Histogram classes ask for a collection in a given ordering instead of
+ *  sorting the collection in place: the view is built once per event and
+ *  shared read-only by all histogram instances, and the collection of the
+ *  event is not modified.
+ *
+ *  A cached view is reused as long as the run and event number and the
+ *  address and size of the collection are unchanged. A cleaner modifying
+ *  the collections in place does not change these, so the cycle calls
+ *  Invalidate() (through EventContext::Invalidate()) after cleaning the
+ *  jets of an event whose views may already be in use.
+ *
+ *  The cache is owned by the EventContext.
+ *
+ *  Usage:
+ *    const IndexView<TopJet>& cajets = SortedViewCache::Instance()->Get(calc->GetCAJets());
+ *    if(cajets.size()>0) cajets[0].pt();
+ */
+
+class SortedViewCache {
+
+public:
+  enum E_Ordering { e_HigherPt, e_HigherMass };
+
+  /// Instance of the cache
+  static SortedViewCache* Instance();
+
+  /// View on jets in the given ordering for the current event
+  const IndexView<Jet>& Get(const std::vector<Jet>* jets, E_Ordering ordering=e_HigherPt);
+  /// View on top jets in the given ordering for the current event
+  const IndexView<TopJet>& Get(const std::vector<TopJet>* topjets, E_Ordering ordering=e_HigherPt);
+
+  /// Rebuild all views on their next use, call after a cleaner changed the collections
+  void Invalidate();
+  /// Forget all views, e.g. at the end of an input data
+  void Clear();
+
+private:
+  friend class EventContext;
+  SortedViewCache() {}
+  SortedViewCache(const SortedViewCache&);
+  SortedViewCache& operator=(const SortedViewCache&);
+
+  template<typename T>
+  struct Entry {
+    const std::vector<T>* collection;
+    E_Ordering ordering;
+    int run;
+    int event;
+    unsigned int size;
+    const T* data;
+    bool valid;
+    IndexView<T> view;
+  };
+
+  template<typename T>
+  const IndexView<T>& Lookup(std::deque<Entry<T> >& entries, const std::vector<T>* collection, E_Ordering ordering);
+
+  // deques keep references to earlier views valid when new ones are added
+  std::deque<Entry<Jet> > m_jets;
+  std::deque<Entry<TopJet> > m_topjets;
+
+}; // class SortedViewCache
+
+#endif // SortedViewCache_H
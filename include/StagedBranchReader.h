@@ -0,0 +1,80 @@
+// Dear emacs, this is -*- c++ -*-
+#ifndef StagedBranchReader_H
+#define StagedBranchReader_H
+
+#include <string>
+#include <vector>
+#include <set>
+
+// ROOT include(s):
+#include <TTree.h>
+#include <TBranch.h>
+
+// SFrame include(s):
+#include "core/include/SLogger.h"
+
+/**
+ *  @short Two-stage reading of the input tree
+ *
+ *  Only the branches needed for the first cuts of a cycle are read for
+ *  every entry, all other connected object branches are switched off
+ *  after AnalysisCycle::BeginInputFile and are read with LoadDeferred()
+ *  for the events surviving these cuts, e.g. right before WriteOutputTree().
+ *
+ *  The early branches are declared by the address of the member of the
+ *  BaseCycleContainer they are connected to (e.g. &bcc->electrons) or by
+ *  their name in the input tree. Branches of basic types, trigger
+ *  information and the generator info are always read. If one of the
+ *  declared members is not connected to a branch, nothing is deferred.
+ *
+ *  Collections read in the second stage still hold the content of the
+ *  previous survivor before LoadDeferred() is called, so they must not be
+ *  used by the first cuts.
+ */
+
+class StagedBranchReader {
+
+public:
+  /// Named constructor
+  StagedBranchReader(const char* name = "StagedBranchReader");
+  /// Default destructor
+  ~StagedBranchReader();
+
+  /// Declare the member of the BaseCycleContainer the branch is connected to as needed by the first cuts
+  void AddEarly(const void* address);
+  /// Declare an input branch as needed by the first cuts
+  void AddEarlyBranch(const std::string& name);
+  /// Declare all space-separated input branches as needed by the first cuts
+  void AddEarlyBranches(const std::string& names);
+
+  /// Switch off all connected branches of tree not needed early, call after connecting the variables
+  void Setup(TTree* tree);
+
+  /// Read the deferred branches for the current entry
+  void LoadDeferred();
+
+  /// Number of branches read in the second stage
+  unsigned int NDeferred() const { return m_deferred.size(); }
+
+  /// Print the number of events and bytes read in the second stage
+  void PrintStatistics();
+
+private:
+  void SetProcess(TBranch* branch, bool process);
+
+  std::set<const void*> m_early_addresses;
+  std::set<std::string> m_early_names;
+
+  TTree* m_tree;
+  TBranch* m_reference;
+  std::vector<TBranch*> m_deferred;
+  Long64_t m_loaded_entry;
+
+  unsigned long m_nloaded;
+  double m_bytes;
+
+  mutable SLogger m_logger;
+
+}; // class StagedBranchReader
+
+#endif // StagedBranchReader_H
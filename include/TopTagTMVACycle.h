@@ -5,6 +5,7 @@
 
 // SFrame include(s):
 #include "include/AnalysisCycle.h"
+#include "include/OutputPolicy.h"
 
 /**
  *   @short Example of an analysis cycle
@@ -46,6 +47,12 @@ private:
   // Put all your private variables here
   //
 
+  std::string m_output_compression;
+  OutputPolicy* m_output_policy;
+
+  // selections used in ExecuteEvent, set in BeginInputData
+  Selection* m_CAJetSel;
+
   // Macro adding the functions for dictionary generation
   ClassDef( TopTagTMVACycle, 0 );
 
@@ -0,0 +1,90 @@
+// Dear emacs, this is -*- c++ -*-
+#ifndef TreeWriter_H
+#define TreeWriter_H
+
+#include <string>
+#include <vector>
+#include <deque>
+
+// ROOT include(s):
+#include <TTree.h>
+
+class OutputPolicy;
+
+/**
+ *  @short Single-fill writer for an output tree shared by several fillers
+ *
+ *  Fillers register typed columns in their Init() and set the values
+ *  through the returned pointers in their Fill(); the addresses stay
+ *  valid until the next SetTree(). The cycle calls Commit() once per
+ *  event, at the beginning of ExecuteEvent for the previous event
+ *  (skipped events leave with an exception) and in EndInputData. A row
+ *  is written only if a filler called Touch() since the last Commit();
+ *  columns not set by any filler hold their default value, never the
+ *  value of an earlier event.
+ *
+ *  With an OutputPolicy, Float_t columns are rounded to its precision
+ *  when the row is written and Bool_t columns can be packed into the
+ *  bits of one UInt_t column "flags"; each flag stays available by its
+ *  name as an alias of the tree.
+ *
+ *  Usage:
+ *    m_pt = writer->AddFloat("pt");   // Init()
+ *    *m_pt = muon.pt();               // Fill()
+ *    writer->Touch();
+ */
+
+class TreeWriter {
+
+public:
+  /// Default constructor
+  TreeWriter();
+  /// Default destructor
+  ~TreeWriter();
+
+  /// Write to tree, removes all columns registered before
+  void SetTree(TTree* tree);
+  /// Precision and packing of the columns registered afterwards, null for none
+  void SetPolicy(const OutputPolicy* policy) { m_policy = policy; }
+
+  /// Add a Float_t column with default value 0
+  Float_t* AddFloat(const char* name);
+  /// Add an Int_t column with default value 0
+  Int_t* AddInt(const char* name);
+  /// Add a Bool_t column with default value false
+  Bool_t* AddBool(const char* name);
+
+  /// Mark the current row as filled
+  void Touch() { m_touched = true; }
+
+  /// Write the current row if it was filled and reset all columns
+  void Commit();
+
+  /// Number of rows written to the current tree
+  Long64_t Rows() const { return m_rows; }
+
+private:
+  TreeWriter(const TreeWriter&);
+  TreeWriter& operator=(const TreeWriter&);
+
+  void Reset();
+
+  TTree* m_tree;
+  const OutputPolicy* m_policy;
+
+  std::deque<Float_t> m_floats;
+  std::deque<Int_t> m_ints;
+  std::deque<Bool_t> m_bools;
+
+  // mantissa bits of the Float_t columns, -1 for full precision
+  std::vector<int> m_float_bits;
+  // Bool_t columns stored in bit i of m_flags
+  std::vector<unsigned int> m_flag_columns;
+  UInt_t m_flags;
+
+  bool m_touched;
+  Long64_t m_rows;
+
+}; // class TreeWriter
+
+#endif // TreeWriter_H
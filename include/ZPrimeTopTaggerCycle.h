@@ -76,8 +76,18 @@ private:
 
   bool m_mttgencut;
 
+  bool m_histogram_only;
 
 
+  // selections used in ExecuteEvent, set in BeginInputData
+  Selection* m_BSel;
+  Selection* m_MuonSel;
+  Selection* m_NoBSel;
+  Selection* m_TopSel;
+  Selection* m_TopTagSel;
+  Selection* m_TwoDMuon;
+  Selection* m_mttbar_gen_selection;
+
   // Macro adding the functions for dictionary generation
   ClassDef( ZPrimeTopTaggerCycle, 0 );
 
@@ -22,6 +22,7 @@
 #pragma link C++ class ZprimeSelectionDataTrigTestCycle+;
 #pragma link C++ class ZprimeEleTrigCycle+;
 #pragma link C++ class DileptonPreSelectionCycle+;
+#pragma link C++ class ZprimeMultiPreSelectionCycle+;
 
 
 #pragma link C++ class TopTagTMVACycle+;
@@ -5,6 +5,8 @@
 // SFrame include(s):
 #include "include/AnalysisCycle.h"
 #include "Cleaner.h"
+#include "include/EventArena.h"
+#include "include/EventRandom.h"
 #include "HypothesisDiscriminator.h"
 #include "HypothesisHists.h"
 #include "include/SelectionModules.h"
@@ -58,6 +60,7 @@ private:
   int m_Nbtags_max;
   int m_Nbtags_min;  
 
+  EventArena* m_arena;
   Cleaner* m_cleaner;
   Chi2Discriminator* m_chi2discr;
   BestPossibleDiscriminator* m_bpdiscr;
@@ -76,6 +79,19 @@ private:
 
   bool m_mttgencut;
 
+  bool m_histogram_only;
+
+  // declares the property DeterministicRandom
+  friend class EventRandom;
+  EventRandom* m_event_random;
+
+  // selections used in ExecuteEvent, set in BeginInputData
+  Selection* m_mttbar_gen_selection;
+  Selection* m_std_mu_selection;
+  Selection* m_std_mu_selection2;
+  Selection* m_triangularcut_selection;
+  Selection* m_ele_trig_selection;
+
   // Macro adding the functions for dictionary generation
   ClassDef( ZprimeEleTrigCycle, 0 );
 
@@ -0,0 +1,131 @@
+// Dear emacs, this is -*- c++ -*-
+#ifndef ZprimeMultiPreSelectionCycle_H
+#define ZprimeMultiPreSelectionCycle_H
+
+#include <string>
+#include <vector>
+
+// ROOT include(s):
+#include <TFile.h>
+#include <TTree.h>
+
+// SFrame include(s):
+#include "include/AnalysisCycle.h"
+#include "Cleaner.h"
+#include "include/StagedBranchReader.h"
+#include "include/CollectionCheckpoint.h"
+#include "include/OutputPolicy.h"
+#include "include/InputCacheMonitor.h"
+#include "include/EventRandom.h"
+
+/**
+ *  @short Pre-selection for Z'->ttbar analysis writing several channel skims in one read
+ *
+ *  Runs the pre-selections of ZprimePreSelectionCycle (channels "ele" and
+ *  "mu"), DileptonPreSelectionCycle ("diele", "dimu") and
+ *  ZprimeJetHTPreSelectionCycle ("jetht") in one event loop. Every channel
+ *  listed in the Channels property writes the events passing its selection
+ *  to its own tree, a copy of the structure of the input tree, in
+ *  <ChannelOutputDirectory>/ZprimeMultiPreSelectionCycle.<Type>.<Version>.<channel>.<N>.root
+ *  with N the number of the PROOF worker (0 for local jobs).
+ *
+ *  As in the single cycles, the written events contain the cleaned leptons
+ *  and the uncleaned jets and MET. The lepton cleaning of the dilepton and
+ *  JetHT skims differs from the lepton+jets one, so the collections are
+ *  cleaned once for each cleaning used by the channels.
+ */
+
+
+class ZprimeMultiPreSelectionCycle : public AnalysisCycle {
+
+public:
+  /// Default constructor
+  ZprimeMultiPreSelectionCycle();
+  /// Default destructor
+  ~ZprimeMultiPreSelectionCycle();
+
+  /// Function called at the beginning of the cycle
+  void BeginCycle() throw( SError );
+  /// Function called at the end of the cycle
+  void EndCycle() throw( SError );
+
+  /// Function called at the beginning of a new input data
+  void BeginInputData( const SInputData& ) throw( SError );
+  /// Function called after finishing to process an input data
+  void EndInputData  ( const SInputData& ) throw( SError );
+
+  /// Function called after opening each new input file
+  void BeginInputFile( const SInputData& ) throw( SError );
+
+  /// Function called for every event
+  void ExecuteEvent( const SInputData&, Double_t ) throw( SError );
+
+private:
+  //
+  // Put all your private variables here
+  //
+
+  /// Lepton cleaning of a channel
+  enum E_ChannelCleaning { e_CleaningLeptonJets, e_CleaningDilepton, e_NCleanings };
+
+  /// One skim written by the cycle
+  struct Channel {
+    std::string name;
+    E_ChannelCleaning cleaning;
+    Selection* selection;
+    // JetHT skim: additionally HLT_HT750 or HLT_PFJet320 and at least one lepton
+    bool jetht;
+    TFile* file;
+    TTree* tree;
+    unsigned long nevents;
+    bool passed;
+  };
+
+  /// Create the output file and tree of channel from the structure of the input tree
+  void OpenChannel( Channel& channel, const SInputData& id, TTree* input );
+  /// Write and close the output of channel
+  void CloseChannel( Channel& channel );
+  /// Clean the collections with the given lepton cleaning
+  void Clean( E_ChannelCleaning cleaning );
+
+  // Flg use to reverse electron selection
+  bool m_reversed_electron_selection;
+
+  // space separated list of the channels written: ele mu diele dimu jetht
+  std::string m_channel_names;
+  std::string m_channel_dir;
+  std::vector<Channel> m_channels;
+
+  Selection* m_trig1sel;
+  Selection* m_trig2sel;
+  Selection* m_elesel;
+  Selection* m_muonsel;
+
+  // two-stage reading of the input tree
+  bool m_staged_reading;
+  std::string m_staged_early_branches;
+  StagedBranchReader* m_staged_reader;
+
+  // collections before the cleaning of the channels
+  CollectionCheckpoint<Electron>* m_electrons_checkpoint;
+  CollectionCheckpoint<Muon>* m_muons_checkpoint;
+  CollectionCheckpoint<Jet>* m_jets_checkpoint;
+  ObjectCheckpoint<MET>* m_met_checkpoint;
+
+  std::string m_output_compression;
+  OutputPolicy* m_output_policy;
+
+  // declares the properties InputCache*
+  friend class InputCacheMonitor;
+  InputCacheMonitor* m_input_cache;
+
+  // declares the property DeterministicRandom
+  friend class EventRandom;
+  EventRandom* m_event_random;
+
+  // Macro adding the functions for dictionary generation
+  ClassDef( ZprimeMultiPreSelectionCycle, 0 );
+
+}; // class ZprimeMultiPreSelectionCycle
+
+#endif // ZprimeMultiPreSelectionCycle_H
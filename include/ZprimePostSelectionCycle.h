@@ -17,6 +17,18 @@
 #include "TauHists.h"
 #include "TopJetHists.h"
 #include "BTagEffHists.h"
+#include "PDFWeightColumns.h"
+#include "EventListWriter.h"
+#include "EventIndex.h"
+#include "InputCacheMonitor.h"
+#include "BranchUsageTracker.h"
+#include "FlatEventCache.h"
+#include "ProofPacketScheduler.h"
+#include "EventRandom.h"
+
+#include <set>
+
+class PDFWeights;
 
 /**
  *   @short Example of an analysis cycle
@@ -47,6 +59,11 @@ public:
   /// Function called after finishing to process an input data
   void EndInputData  ( const SInputData& ) throw( SError );
 
+  /// Function called on the master before the workers start an input data
+  void BeginMasterInputData( const SInputData& ) throw( SError );
+  /// Function called on the master after all workers finished an input data
+  void EndMasterInputData( const SInputData& ) throw( SError );
+
   /// Function called after opening each new input file
   void BeginInputFile( const SInputData& ) throw( SError );
 
@@ -60,6 +77,11 @@ public:
   void ScaleHistos(TString postfix="", double scale=1.0);
 
 private:
+  /// True if the PDF weight file is written or read for id
+  bool PDFColumnsUsed( const SInputData& id ) const;
+  /// PDF weight file of id without the extension
+  std::string PDFColumnsBaseName( const SInputData& id ) const;
+
   //
   // Put all your private variables here
   //
@@ -76,7 +98,20 @@ private:
   bool m_mttgencut;
 
   bool m_writeeventlist;
-  ofstream m_eventlist;
+  std::string m_eventlist_dir;
+  // categories of the selected events in the event list
+  enum E_EventListCategory {
+    e_EventListBTag = 1,
+    e_EventListTopTag = 2,
+    e_EventListChi2Sel10 = 4
+  };
+  EventListWriter* m_eventlist;
+
+  std::string m_event_selection_list;
+  std::string m_event_index_dir;
+  EventIndex* m_event_index;
+  std::vector<EventIndex::Record> m_selected_events;
+  std::set<Long64_t> m_selected_entries;
 
   std::string m_flavor_selection;
   std::string m_filter_file;
@@ -84,6 +119,57 @@ private:
   bool m_applyEleORJetTriggerSF;
   bool m_correctTopPtWeights;
 
+  // per-event weights of all PDF members in a compact side file
+  std::string m_pdfcolumns_dir;
+  std::string m_pdfcolumns_pdfname;
+  std::string m_pdfcolumns_weightdir;
+  bool m_pdfcolumns_write;
+  int m_pdfcolumns_index;
+  PDFWeightColumns* m_pdfcolumns;
+  PDFWeights* m_pdfcolumns_weights;
+
+  std::string m_used_branches_file;
+  std::set<std::string> m_used_branches;
+  TTree* m_input_tree;
+
+  // declares the properties InputCache*
+  friend class InputCacheMonitor;
+  InputCacheMonitor* m_input_cache;
+
+  int m_branch_usage_learn_events;
+  std::string m_branch_usage_keep;
+  BranchUsageTracker* m_branch_usage;
+
+  std::string m_flatcache_dir;
+  FlatEventCache* m_flatcache;
+
+  Chi2Discriminator* m_chi2discr;
+
+  // declares the properties Proof*
+  friend class ProofPacketScheduler;
+  ProofPacketScheduler* m_proof_scheduler;
+
+  // declares the property DeterministicRandom
+  friend class EventRandom;
+  EventRandom* m_event_random;
+
+  bool m_histogram_only;
+
+  // selections used in ExecuteEvent, set in BeginInputData
+  Selection* m_LeadingJetSelection;
+  Selection* m_KinematicSelection;
+  Selection* m_TopTagSelection;
+  Selection* m_Chi2Selection50;
+  Selection* m_Chi2Selection10;
+  Selection* m_BTagSelection;
+  Selection* m_NoBTagSelection;
+  Selection* m_CMSSubBTagNsubjSelection;
+  Selection* m_CMSSubBTagSelection;
+  Selection* m_SumBTags0Selection;
+  Selection* m_SumBTags1Selection;
+  Selection* m_SumBTags2Selection;
+  Selection* m_mttbar_gen_selection;
+
   // Macro adding the functions for dictionary generation
   ClassDef( ZprimePostSelectionCycle, 0 );
 }; // class ZprimePostSelectionCycle
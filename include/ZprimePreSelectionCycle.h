@@ -5,6 +5,12 @@
 // SFrame include(s):
 #include "include/AnalysisCycle.h"
 #include "Cleaner.h"
+#include "include/StagedBranchReader.h"
+#include "include/CollectionCheckpoint.h"
+#include "include/OutputPolicy.h"
+#include "include/InputCacheMonitor.h"
+#include "include/ProofPacketScheduler.h"
+#include "include/EventRandom.h"
 
 /**
  *  @short Selection cycle to perform 
@@ -31,6 +37,11 @@ public:
   /// Function called after finishing to process an input data
   void EndInputData  ( const SInputData& ) throw( SError );
 
+  /// Function called on the master before the workers start an input data
+  void BeginMasterInputData( const SInputData& ) throw( SError );
+  /// Function called on the master after all workers finished an input data
+  void EndMasterInputData( const SInputData& ) throw( SError );
+
   /// Function called after opening each new input file
   void BeginInputFile( const SInputData& ) throw( SError );
 
@@ -47,6 +58,33 @@ private:
 
   std::string m_Electron_Or_Muon_Selection;
 
+  // two-stage reading of the input tree
+  bool m_staged_reading;
+  std::string m_staged_early_branches;
+  StagedBranchReader* m_staged_reader;
+
+  // uncleaned jets and MET, written to the output tree
+  CollectionCheckpoint<Jet>* m_jets_checkpoint;
+  ObjectCheckpoint<MET>* m_met_checkpoint;
+
+  std::string m_output_compression;
+  OutputPolicy* m_output_policy;
+
+  // declares the properties InputCache*
+  friend class InputCacheMonitor;
+  InputCacheMonitor* m_input_cache;
+
+  // declares the properties Proof*
+  friend class ProofPacketScheduler;
+  ProofPacketScheduler* m_proof_scheduler;
+
+  // declares the property DeterministicRandom
+  friend class EventRandom;
+  EventRandom* m_event_random;
+
+  // selections used in ExecuteEvent, set in BeginInputData
+  Selection* m_preselection;
+
   // Macro adding the functions for dictionary generation
   ClassDef( ZprimePreSelectionCycle, 0 );
 
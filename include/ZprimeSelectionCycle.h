@@ -5,10 +5,15 @@
 // SFrame include(s):
 #include "include/AnalysisCycle.h"
 #include "Cleaner.h"
+#include "include/EventArena.h"
+#include "include/IndexView.h"
 #include "HypothesisDiscriminator.h"
 #include "HypothesisHists.h"
 #include "include/SelectionModules.h"
 #include "HypothesisStatistics.h"
+#include "include/AdaptiveSelectionChain.h"
+#include "include/OutputPolicy.h"
+#include "include/SkimBranchFilter.h"
 
 #include "EventHists.h"
 #include "JetHists.h"
@@ -16,6 +21,8 @@
 #include "MuonHists.h"
 #include "TauHists.h"
 #include "TopJetHists.h"
+#include "InputCacheMonitor.h"
+#include "EventRandom.h"
 
 /**
  *  @short Selection cycle to perform 
@@ -69,6 +76,16 @@ private:
   bool m_veto_electron_trigger;
   bool m_useORTriggerWithPFJet320;
 
+  int m_adaptive_selection_events;
+  AdaptiveSelectionChain* m_first_chain;
+
+  EventArena* m_arena;
+
+  std::string m_output_compression;
+  OutputPolicy* m_output_policy;
+
+  std::string m_skim_branches;
+  std::string m_skim_branches_file;
   Cleaner* m_cleaner;
   Chi2Discriminator* m_chi2discr;
   BestPossibleDiscriminator* m_bpdiscr;
@@ -81,6 +98,26 @@ private:
   HypothesisStatistics* m_cm_sumdr; 
   HypothesisStatistics* m_cm_bp; 
 
+  // declares the properties InputCache*
+  friend class InputCacheMonitor;
+  InputCacheMonitor* m_input_cache;
+
+  // declares the property DeterministicRandom
+  friend class EventRandom;
+  EventRandom* m_event_random;
+
+  // selections used in ExecuteEvent, set in BeginInputData
+  Selection* m_mttbar_gen_selection;
+  Selection* m_Ele30trig_selection;
+  Selection* m_PFJet320trig_selection;
+  Selection* m_trig_selection;
+  Selection* m_first_selection;
+  Selection* m_second_selection;
+  Selection* m_trangularcut_selection;
+  Selection* m_chi2_selection;
+  Selection* m_matchable_selection;
+  Selection* m_TopTagSel;
+
   // Macro adding the functions for dictionary generation
   ClassDef( ZprimeSelectionCycle, 0 );
 
@@ -5,6 +5,8 @@
 // SFrame include(s):
 #include "include/AnalysisCycle.h"
 #include "Cleaner.h"
+#include "include/EventArena.h"
+#include "include/EventRandom.h"
 #include "HypothesisDiscriminator.h"
 #include "ElectronHists.h"
 #include "MuonHists.h"
@@ -47,10 +49,21 @@ private:
   int m_Nbtags_min;  
   bool doEle;
   bool doMu;
+  EventArena* m_arena;
   Cleaner* m_cleaner;
+  // declares the property DeterministicRandom
+  friend class EventRandom;
+  EventRandom* m_event_random;
   Chi2Discriminator* m_chi2discr;
   BestPossibleDiscriminator* m_bpdiscr;
 
+  // selections used in ExecuteEvent, set in BeginInputData
+  Selection* m_trig_selection;
+  Selection* m_reftrig_selection;
+  Selection* m_first_selection;
+  Selection* m_second_selection;
+  Selection* m_chi2_selection;
+
   // Macro adding the functions for dictionary generation
   ClassDef( ZprimeSelectionDataTrigTestCycle, 0 );
 
@@ -6,6 +6,8 @@
 #include "AnalysisCycle.h"
 #include "FactorizedJetCorrector.h"
 #include "Cleaner.h"
+#include "include/EventArena.h"
+#include "include/EventRandom.h"
 #include "HypothesisDiscriminator.h"
 #include "ElectronHists.h"
 #include "MuonHists.h"
@@ -50,10 +52,20 @@ private:
   bool doEle;
   bool doMu;
   FactorizedJetCorrector* m_corrector;
+  EventArena* m_arena;
   Cleaner* m_cleaner;
+  // declares the property DeterministicRandom
+  friend class EventRandom;
+  EventRandom* m_event_random;
   Chi2Discriminator* m_chi2discr;
   BestPossibleDiscriminator* m_bpdiscr;
 
+  // selections used in ExecuteEvent, set in BeginInputData
+  Selection* m_trig_selection;
+  Selection* m_first_selection;
+  Selection* m_second_selection;
+  Selection* m_chi2_selection;
+
   // Macro adding the functions for dictionary generation
   ClassDef( ZprimeSelectionTrigTestCycle, 0 );
 
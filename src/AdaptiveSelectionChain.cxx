@@ -0,0 +1,240 @@
+#include "include/AdaptiveSelectionChain.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <time.h>
+
+using namespace std;
+
+namespace {
+
+  double WallTime(){
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1e-9*ts.tv_nsec;
+  }
+
+  // orders module indices by their rank, lower rank first
+  struct LowerRank {
+    const vector<double>* ranks;
+    LowerRank(const vector<double>* r): ranks(r) {}
+    bool operator()(unsigned int a, unsigned int b) const { return ranks->at(a) < ranks->at(b); }
+  };
+
+}
+
+AdaptiveSelectionChain::AdaptiveSelectionChain(const std::string& name, unsigned int profile_events)
+  : m_name(name), m_profile_events(profile_events), m_nprofiled(0),
+    m_setup(false), m_ordered(false), m_nevents(0), m_logger(name.c_str())
+{
+}
+
+AdaptiveSelectionChain::~AdaptiveSelectionChain()
+{
+  for(unsigned int i=0; i<m_entries.size(); ++i) delete m_entries[i].module;
+}
+
+void AdaptiveSelectionChain::addSelectionModule(SelectionModule* module, bool commutative)
+{
+  if(m_entries.size()>=64){
+    m_logger << ERROR << "at most 64 modules are supported by an adaptive chain" << SLogger::endmsg;
+    throw SError( "AdaptiveSelectionChain: too many modules", SError::StopExecution );
+  }
+
+  Entry entry;
+  entry.module = module;
+  entry.min = 0;
+  entry.max = 0;
+  entry.commutative = commutative;
+  entry.implied_by = -1;
+  entry.time = 0;
+  entry.ncalls = 0;
+  entry.npass = 0;
+  entry.ncutflow = 0;
+  m_entries.push_back(entry);
+}
+
+void AdaptiveSelectionChain::addCountSelectionModule(SelectionModule* module, const std::string& key, int min, int max)
+{
+  addSelectionModule(module, true);
+  m_entries.back().key = key;
+  m_entries.back().min = min;
+  m_entries.back().max = max;
+}
+
+void AdaptiveSelectionChain::AttachTo(Selection* sel)
+{
+  for(unsigned int i=0; i<m_entries.size(); ++i) sel->addSelectionModule(m_entries[i].module);
+  m_entries.clear();
+}
+
+std::string AdaptiveSelectionChain::description()
+{
+  return "adaptive chain " + m_name;
+}
+
+void AdaptiveSelectionChain::Setup()
+{
+  // drop counting modules implied by a narrower one on the same collection
+  // within the same segment; equal ranges keep the first module
+  unsigned int begin=0;
+  while(begin<m_entries.size()){
+    unsigned int end=begin+1;
+    if(m_entries[begin].commutative){
+      while(end<m_entries.size() && m_entries[end].commutative) ++end;
+    }
+
+    for(unsigned int i=begin; i<end; ++i){
+      Entry& ei = m_entries[i];
+      if(ei.key.empty()) continue;
+      for(unsigned int j=begin; j<end; ++j){
+        const Entry& ej = m_entries[j];
+        if(i==j || ej.key!=ei.key || ej.implied_by>=0) continue;
+        if(ej.min<ei.min || ej.max>ei.max) continue;
+        if(ej.min==ei.min && ej.max==ei.max && j>i) continue;
+        ei.implied_by = j;
+        break;
+      }
+    }
+
+    std::vector<unsigned int> segment;
+    for(unsigned int i=begin; i<end; ++i){
+      if(m_entries[i].implied_by<0) segment.push_back(i);
+    }
+    m_segments.push_back(segment);
+    begin=end;
+  }
+
+  // resolve implications onto active modules for the report
+  for(unsigned int i=0; i<m_entries.size(); ++i){
+    int j = m_entries[i].implied_by;
+    while(j>=0 && m_entries[j].implied_by>=0) j = m_entries[j].implied_by;
+    m_entries[i].implied_by = j;
+    if(j>=0){
+      m_logger << INFO << "dropping '" << m_entries[i].module->description()
+               << "', implied by '" << m_entries[j].module->description() << "'" << SLogger::endmsg;
+    }
+  }
+
+  for(unsigned int s=0; s<m_segments.size(); ++s){
+    m_order.insert(m_order.end(), m_segments[s].begin(), m_segments[s].end());
+  }
+
+  m_setup = true;
+  if(m_profile_events==0) m_ordered = true;
+}
+
+bool AdaptiveSelectionChain::pass(BaseCycleContainer* bcc)
+{
+  if(!m_setup) Setup();
+
+  ++m_nevents;
+
+  if(!m_ordered) return ProfilePass(bcc);
+
+  for(unsigned int i=0; i<m_order.size(); ++i){
+    Entry& entry = m_entries[m_order[i]];
+    if(!entry.module->pass(bcc)) return false;
+    ++entry.ncutflow;
+  }
+  return true;
+}
+
+bool AdaptiveSelectionChain::ProfilePass(BaseCycleContainer* bcc)
+{
+  // evaluate every module of a segment to get independent pass rates,
+  // stop after the first failing segment since later ones may rely on it
+  ULong64_t evaluated=0;
+  ULong64_t passed=0;
+  bool result=true;
+
+  for(unsigned int s=0; s<m_segments.size() && result; ++s){
+    for(unsigned int i=0; i<m_segments[s].size(); ++i){
+      unsigned int idx = m_segments[s][i];
+      Entry& entry = m_entries[idx];
+
+      double start = WallTime();
+      bool ok = entry.module->pass(bcc);
+      entry.time += WallTime()-start;
+      ++entry.ncalls;
+
+      evaluated |= (ULong64_t(1) << idx);
+      if(ok){
+        ++entry.npass;
+        passed |= (ULong64_t(1) << idx);
+      } else {
+        result = false;
+      }
+    }
+  }
+
+  m_evaluated.push_back(evaluated);
+  m_passed.push_back(passed);
+
+  if(++m_nprofiled>=m_profile_events) Reorder();
+
+  return result;
+}
+
+double AdaptiveSelectionChain::Rank(const Entry& entry) const
+{
+  if(entry.ncalls==0) return 0;
+  double cost = entry.time/entry.ncalls;
+  double rejection = 1. - double(entry.npass)/entry.ncalls;
+  if(rejection<=0) return 1e30*(1.+cost);
+  return cost/rejection;
+}
+
+void AdaptiveSelectionChain::Reorder()
+{
+  std::vector<double> ranks(m_entries.size(), 0.);
+  for(unsigned int i=0; i<m_entries.size(); ++i) ranks[i] = Rank(m_entries[i]);
+
+  m_order.clear();
+  for(unsigned int s=0; s<m_segments.size(); ++s){
+    std::stable_sort(m_segments[s].begin(), m_segments[s].end(), LowerRank(&ranks));
+    m_order.insert(m_order.end(), m_segments[s].begin(), m_segments[s].end());
+  }
+
+  // replay the profiled events to get the cut flow in the new order
+  for(unsigned int ev=0; ev<m_passed.size(); ++ev){
+    for(unsigned int i=0; i<m_order.size(); ++i){
+      ULong64_t bit = ULong64_t(1) << m_order[i];
+      if(!(m_evaluated[ev] & bit) || !(m_passed[ev] & bit)) break;
+      ++m_entries[m_order[i]].ncutflow;
+    }
+  }
+  m_evaluated.clear();
+  m_passed.clear();
+
+  m_ordered = true;
+
+  m_logger << INFO << "module order after " << m_nprofiled << " events:" << SLogger::endmsg;
+  for(unsigned int i=0; i<m_order.size(); ++i){
+    const Entry& entry = m_entries[m_order[i]];
+    m_logger << INFO << "  " << entry.module->description()
+             << "  (" << 1e6*entry.time/std::max(entry.ncalls,1ul) << " us/event, pass rate "
+             << double(entry.npass)/std::max(entry.ncalls,1ul) << ")" << SLogger::endmsg;
+  }
+}
+
+void AdaptiveSelectionChain::PrintCutFlow()
+{
+  if(!m_setup) return;
+  if(!m_ordered && m_nprofiled>0) Reorder();
+
+  m_logger << INFO << "-------------------------------------------------" << SLogger::endmsg;
+  m_logger << INFO << "cut flow of adaptive chain " << m_name << SLogger::endmsg;
+  m_logger << INFO << std::setw(12) << m_nevents << "  events" << SLogger::endmsg;
+  for(unsigned int i=0; i<m_order.size(); ++i){
+    const Entry& entry = m_entries[m_order[i]];
+    m_logger << INFO << std::setw(12) << entry.ncutflow << "  " << entry.module->description() << SLogger::endmsg;
+  }
+  for(unsigned int i=0; i<m_entries.size(); ++i){
+    const Entry& entry = m_entries[i];
+    if(entry.implied_by<0) continue;
+    m_logger << INFO << std::setw(12) << "-" << "  " << entry.module->description()
+             << " (implied by " << m_entries[entry.implied_by].module->description() << ")" << SLogger::endmsg;
+  }
+  m_logger << INFO << "-------------------------------------------------" << SLogger::endmsg;
+}
@@ -0,0 +1,207 @@
+#include "include/BranchUsageTracker.h"
+
+#include <sstream>
+
+// ROOT include(s):
+#include <TBranchElement.h>
+#include <TObjArray.h>
+#include <TClass.h>
+#include <TVirtualCollectionProxy.h>
+
+// SFrame include(s):
+#include "include/EventCalc.h"
+
+using namespace std;
+
+BranchUsageTracker::BranchUsageTracker(const char* name)
+  : m_learn_events(0), m_nevents(0), m_learning(false), m_ndisabled(0),
+    m_tree(0), m_reference(0), m_logger(name)
+{
+}
+
+BranchUsageTracker::~BranchUsageTracker()
+{
+}
+
+void BranchUsageTracker::Configure(unsigned long nevents)
+{
+  m_learn_events = nevents;
+  m_nevents = 0;
+  m_learning = nevents>0;
+  m_ndisabled = 0;
+  m_used_addresses.clear();
+  m_disabled_names.clear();
+  m_fallback_names.clear();
+  m_tree = 0;
+  m_reference = 0;
+  m_branches.clear();
+}
+
+void BranchUsageTracker::Require(const void* address)
+{
+  m_required_addresses.insert(address);
+}
+
+void BranchUsageTracker::RequireBranches(const std::string& names)
+{
+  std::istringstream stream(names);
+  std::string name;
+  while(stream >> name) m_required_names.insert(name);
+}
+
+void BranchUsageTracker::SetProcess(TBranch* branch, bool process)
+{
+  if(process) branch->ResetBit(TBranch::kDoNotProcess);
+  else branch->SetBit(TBranch::kDoNotProcess);
+
+  TObjArray* branches = branch->GetListOfBranches();
+  for(int i=0; i<branches->GetEntriesFast(); ++i){
+    SetProcess((TBranch*) branches->At(i), process);
+  }
+}
+
+void BranchUsageTracker::Clear(const ConnectedBranch& connected)
+{
+  // the member points to the object read by the branch
+  void* object = *(void* const*) connected.address;
+  TClass* cl = TClass::GetClass(((TBranchElement*) connected.branch)->GetClassName());
+  if(!object || !cl || !cl->GetCollectionProxy()) return;
+
+  TVirtualCollectionProxy* proxy = cl->GetCollectionProxy();
+  TVirtualCollectionProxy::TPushPop helper(proxy, object);
+  proxy->Clear();
+}
+
+void BranchUsageTracker::Setup(TTree* tree)
+{
+  m_tree = tree;
+  m_reference = 0;
+  m_branches.clear();
+  m_ndisabled = 0;
+
+  if(!tree || !m_learn_events) return;
+
+  // always needed by AnalysisCycle::ExecuteEvent: trigger names and the pile-up information,
+  // and the GenJetCollection, read by the JER smearing of the Cleaner through the jets
+  BaseCycleContainer* bcc = EventCalc::Instance()->GetBaseCycleContainer();
+  std::set<const void*> always;
+  always.insert(&bcc->triggerNames);
+  always.insert(&bcc->triggerResults);
+  always.insert(&bcc->genInfo);
+  always.insert(&bcc->genjets);
+
+  TObjArray* branches = tree->GetListOfBranches();
+  for(int i=0; i<branches->GetEntriesFast(); ++i){
+    TBranch* branch = (TBranch*) branches->At(i);
+    const void* address = branch->GetAddress();
+    if(!address) continue;
+
+    if(!branch->InheritsFrom(TBranchElement::Class()) || always.count(address)){
+      if(!m_reference) m_reference = branch;
+      continue;
+    }
+
+    ConnectedBranch connected;
+    connected.branch = branch;
+    connected.address = address;
+    connected.enabled = true;
+    m_branches.push_back(connected);
+  }
+
+  // without a branch read for every entry the entry of a fallback is unknown
+  if(!m_reference){
+    m_logger << WARNING << "no branch of " << tree->GetName() << " is always read, reading all branches" << SLogger::endmsg;
+    m_branches.clear();
+    return;
+  }
+
+  // the learning phase ended in one of the previous files
+  for(unsigned int i=0; i<m_branches.size(); ++i){
+    bool disabled = !m_learning && m_disabled_names.count(m_branches[i].branch->GetName());
+    SetProcess(m_branches[i].branch, !disabled);
+    if(disabled){
+      Clear(m_branches[i]);
+      m_branches[i].enabled = false;
+      ++m_ndisabled;
+    }
+  }
+}
+
+void BranchUsageTracker::Update()
+{
+  if(!m_learning) return;
+  if(m_nevents<m_learn_events){
+    ++m_nevents;
+    return;
+  }
+  m_learning = false;
+  Disable();
+}
+
+void BranchUsageTracker::Disable()
+{
+  std::ostringstream names;
+  for(unsigned int i=0; i<m_branches.size(); ++i){
+    ConnectedBranch& connected = m_branches[i];
+    if(!connected.enabled) continue;
+    if(m_used_addresses.count(connected.address)
+       || m_required_addresses.count(connected.address)
+       || m_required_names.count(connected.branch->GetName())) continue;
+
+    SetProcess(connected.branch, false);
+    Clear(connected);
+    connected.enabled = false;
+    ++m_ndisabled;
+    m_disabled_names.insert(connected.branch->GetName());
+    names << " " << connected.branch->GetName();
+  }
+
+  m_logger << INFO << "branches not used in the first " << m_learn_events << " events switched off:"
+           << (m_ndisabled ? names.str() : std::string(" none")) << SLogger::endmsg;
+}
+
+void BranchUsageTracker::Touch(const void* address)
+{
+  if(m_learning){
+    m_used_addresses.insert(address);
+    return;
+  }
+
+  for(unsigned int i=0; i<m_branches.size(); ++i){
+    ConnectedBranch& connected = m_branches[i];
+    if(connected.enabled || connected.address!=address) continue;
+
+    Long64_t entry = m_reference->GetReadEntry();
+    m_logger << WARNING << "branch " << connected.branch->GetName() << " switched off after the learning phase is used in entry "
+             << entry << ", reading it again for all following events" << SLogger::endmsg;
+
+    SetProcess(connected.branch, true);
+    connected.enabled = true;
+    --m_ndisabled;
+    m_disabled_names.erase(connected.branch->GetName());
+    m_fallback_names.insert(connected.branch->GetName());
+
+    if(entry>=0 && connected.branch->GetEntry(entry, 1)<0){
+      m_logger << ERROR << "failed to read branch " << connected.branch->GetName()
+               << " for entry " << entry << SLogger::endmsg;
+      throw SError( SError::SkipEvent );
+    }
+    return;
+  }
+}
+
+void BranchUsageTracker::PrintStatistics()
+{
+  if(!m_learn_events) return;
+
+  std::ostringstream disabled;
+  for(std::set<std::string>::const_iterator it=m_disabled_names.begin(); it!=m_disabled_names.end(); ++it) disabled << " " << *it;
+  std::ostringstream fallback;
+  for(std::set<std::string>::const_iterator it=m_fallback_names.begin(); it!=m_fallback_names.end(); ++it) fallback << " " << *it;
+
+  m_logger << INFO << m_disabled_names.size() << " branches not read:" << disabled.str() << SLogger::endmsg;
+  if(!m_fallback_names.empty()){
+    m_logger << WARNING << m_fallback_names.size() << " branches used after the learning phase, add them with Require():"
+             << fallback.str() << SLogger::endmsg;
+  }
+}
@@ -11,7 +11,7 @@
 using namespace std;
 
 
-CleanerFiller::CleanerFiller(const char* name,  HypothesisDiscriminator *discr, TTree* MetaOutputTree) : BaseHists(name), m_tree(MetaOutputTree)
+CleanerFiller::CleanerFiller(const char* name,  HypothesisDiscriminator *discr, TreeWriter* writer) : BaseHists(name), m_writer(writer)
 {
   // named default constructor
   m_discr = discr;
@@ -25,14 +25,14 @@ CleanerFiller::~CleanerFiller()
 void CleanerFiller::Init()
 {
   
-  //book output tree branches
+  //book output tree columns
   
   //m_tree->Branch("data");
  
-  m_tree->Branch("toptag"    , &m_toptag     , "toptag/D");
-  m_tree->Branch("chi2"      , &m_chi2       , "chi2/D");
-  m_tree->Branch("mtt_clean" , &m_mtt_clean  , "mtt_clean/D");
-  m_tree->Branch("heptoptag" , &m_heptoptag  , "heptoptag/D");
+  m_toptag    = m_writer->AddInt  ("toptag");
+  m_chi2      = m_writer->AddFloat("chi2");
+  m_mtt_clean = m_writer->AddFloat("mtt_clean");
+  m_heptoptag = m_writer->AddInt  ("heptoptag");
 }
 
 void CleanerFiller::Fill()
@@ -66,11 +66,11 @@ void CleanerFiller::Fill()
   std::vector<TopJet>* hepjets = bcc->toptagjets;
 
 
-  m_mtt_clean = (toplep+tophad).isTimelike() ? (toplep+tophad).M() : -sqrt((toplep+tophad).M2());
-  m_chi2 = hyp->discriminator("Chi2");
+  *m_mtt_clean = (toplep+tophad).isTimelike() ? (toplep+tophad).M() : -sqrt((toplep+tophad).M2());
+  *m_chi2 = hyp->discriminator("Chi2");
   
-  m_toptag = 0; 
-  m_heptoptag =0;
+  *m_toptag = 0; 
+  *m_heptoptag =0;
 
 
   double mjet = 0;
@@ -78,14 +78,14 @@ void CleanerFiller::Fill()
   int nsubjets = 0;
 
   for(unsigned int i =0; i<cajets->size(); ++i) 
-     if(TopTag(cajets->at(i),mjet,nsubjets,mmin)) m_toptag += 1;	
+     if(TopTag(cajets->at(i),mjet,nsubjets,mmin)) *m_toptag += 1;	
 
 
   for(unsigned int i =0; i<hepjets->size();++i)
-    if(variableHepTopTag(hepjets->at(i))) m_heptoptag += 1;
+    if(variableHepTopTag(hepjets->at(i))) *m_heptoptag += 1;
 
 
-  m_tree->Fill();
+  m_writer->Touch();
   
 
  
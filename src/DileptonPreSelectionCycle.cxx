@@ -24,12 +24,39 @@ DileptonPreSelectionCycle::DileptonPreSelectionCycle()
     // steering property for data-driven qcd in electron channel
     m_reversed_electron_selection = false;
     DeclareProperty( "ReversedElectronSelection", m_reversed_electron_selection);
+
+    // read leptons, jets, MET and primary vertices for every event,
+    // all other collections only for events passing the preselection
+    m_staged_reading = false;
+    DeclareProperty( "StagedReading", m_staged_reading);
+    // additional input branches needed by the preselection (space separated)
+    DeclareProperty( "StagedEarlyBranches", m_staged_early_branches);
+    m_staged_reader = new StagedBranchReader("StagedBranchReader");
+
+    m_jets_checkpoint = new CollectionCheckpoint<Jet>();
+    m_met_checkpoint = new ObjectCheckpoint<MET>();
+
+    // compression of the output tree: "ALGORITHM:LEVEL" with ZLIB, LZMA or LZ4
+    m_output_compression = "";
+    DeclareProperty( "OutputCompression", m_output_compression );
+    m_output_policy = new OutputPolicy("OutputPolicy");
+
+    m_input_cache = new InputCacheMonitor("InputCacheMonitor");
+    m_input_cache->DeclareProperties(*this);
+
+    m_event_random = new EventRandom();
+    m_event_random->DeclareProperties(*this);
 }
 
 DileptonPreSelectionCycle::~DileptonPreSelectionCycle()
 {
     // destructor
-
+    delete m_staged_reader;
+    delete m_jets_checkpoint;
+    delete m_met_checkpoint;
+    delete m_output_policy;
+    delete m_input_cache;
+    delete m_event_random;
 }
 
 void DileptonPreSelectionCycle::BeginCycle() throw( SError )
@@ -64,6 +91,17 @@ void DileptonPreSelectionCycle::BeginInputData( const SInputData& id ) throw( SE
     // Important: first call BeginInputData of base class
     AnalysisCycle::BeginInputData( id );
 
+    m_event_random->SetSample(id.GetVersion().Data());
+
+    m_input_cache->Configure();
+
+    // compression of the selected events
+    if(m_output_compression != "") {
+        if(!m_output_policy->SetCompression(m_output_compression))
+            throw SError( ("invalid OutputCompression " + m_output_compression).c_str(), SError::StopExecution );
+        m_output_policy->Apply(GetOutputTree("AnalysisTree"));
+    }
+
     // -------------------- set up the selections ---------------------------
 
     Selection* preselection = new Selection("preselection");
@@ -82,6 +120,9 @@ void DileptonPreSelectionCycle::BeginInputData( const SInputData& id ) throw( SE
 
     RegisterSelection(preselection);
 
+    // selections used in ExecuteEvent
+    m_preselection = GetSelection("preselection");
+
     return;
 }
 
@@ -89,6 +130,10 @@ void DileptonPreSelectionCycle::EndInputData( const SInputData& id ) throw( SErr
 {
     AnalysisCycle::EndInputData( id );
 
+    m_input_cache->PrintStatistics();
+
+    if(m_staged_reading) m_staged_reader->PrintStatistics();
+
     return;
 }
 
@@ -100,6 +145,19 @@ void DileptonPreSelectionCycle::BeginInputFile( const SInputData& id ) throw( SE
     // important: call to base function to connect all variables to Ntuples from the input tree
     AnalysisCycle::BeginInputFile( id );
 
+    m_input_cache->Setup(GetInputTree("AnalysisTree"));
+
+    if(m_staged_reading) {
+        BaseCycleContainer* bcc = EventCalc::Instance()->GetBaseCycleContainer();
+        m_staged_reader->AddEarly(&bcc->electrons);
+        m_staged_reader->AddEarly(&bcc->muons);
+        m_staged_reader->AddEarly(&bcc->jets);
+        m_staged_reader->AddEarly(&bcc->met);
+        m_staged_reader->AddEarly(&bcc->pvs);
+        m_staged_reader->AddEarlyBranches(m_staged_early_branches);
+        m_staged_reader->Setup(GetInputTree("AnalysisTree"));
+    }
+
     return;
 }
 
@@ -108,22 +166,22 @@ void DileptonPreSelectionCycle::ExecuteEvent( const SInputData& id, Double_t wei
     // this is the most important part: here the full analysis happens
     // user should implement selections, filling of histograms and results
 
+    m_input_cache->Update();
+
+    m_event_random->SeedEvent(EventCalc::Instance()->GetBaseCycleContainer());
+
     // first step: call Execute event of base class to perform basic consistency checks
     // also, the good-run selection is performed there and the calculator is reset
     AnalysisCycle::ExecuteEvent( id, weight);
 
     Cleaner cleaner;
-    static Selection* preselection = GetSelection("preselection");
 
     EventCalc* calc = EventCalc::Instance();
     BaseCycleContainer* bcc = calc->GetBaseCycleContainer();
 
     //save uncleaned jet collection and MET to be stored in output
-    std::vector<Jet> uncleaned_jets;
-    for(unsigned int i=0; i<bcc->jets->size(); ++i) {
-        uncleaned_jets.push_back(bcc->jets->at(i));
-    }
-    MET uncleaned_met = *bcc->met;
+    m_jets_checkpoint->Save(bcc->jets);
+    m_met_checkpoint->Save(bcc->met);
 
     //clean collections here
 
@@ -135,15 +193,14 @@ void DileptonPreSelectionCycle::ExecuteEvent( const SInputData& id, Double_t wei
 
     //get the jet selections
 
-    if(!preselection->passSelection())  throw SError( SError::SkipEvent );
+    if(!m_preselection->passSelection())  throw SError( SError::SkipEvent );
+
+    //read the remaining collections for the selected event
+    if(m_staged_reading) m_staged_reader->LoadDeferred();
 
     //fill the uncleaned collections back to bcc to store them in output tree
-    bcc->met->set_pt (uncleaned_met.pt());
-    bcc->met->set_phi (uncleaned_met.phi());
-    bcc->jets->clear();
-    for(unsigned int i=0; i<uncleaned_jets.size(); ++i) {
-        bcc->jets->push_back(uncleaned_jets.at(i));
-    }
+    m_met_checkpoint->Restore();
+    m_jets_checkpoint->Restore();
 
     WriteOutputTree();
 
@@ -0,0 +1,26 @@
+#include "include/EventArena.h"
+
+EventArena::EventArena()
+{
+}
+
+EventArena::~EventArena()
+{
+}
+
+Cleaner* EventArena::NewCleaner()
+{
+  m_cleaner = Cleaner();
+  return &m_cleaner;
+}
+
+Cleaner* EventArena::NewCleaner(BaseCycleContainer* bcc)
+{
+  m_cleaner = Cleaner(bcc);
+  return &m_cleaner;
+}
+
+void EventArena::Reset()
+{
+  m_topjet_collections.Reset();
+}
@@ -0,0 +1,21 @@
+#include "include/EventContext.h"
+
+EventContext* EventContext::Instance()
+{
+  static EventContext context;
+  return &context;
+}
+
+void EventContext::Invalidate()
+{
+  m_views.Invalidate();
+  m_jets.Invalidate();
+  m_topjets.Invalidate();
+}
+
+void EventContext::Clear()
+{
+  m_views.Clear();
+  m_jets = JetSoA();
+  m_topjets = JetSoA();
+}
@@ -0,0 +1,226 @@
+#include "include/EventIndex.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+
+// ROOT include(s):
+#include <TBranch.h>
+#include <TLeaf.h>
+#include <TObjArray.h>
+#include <TSystem.h>
+#include <TFile.h>
+
+using namespace std;
+
+namespace {
+  const char s_magic[4] = {'E','V','I','X'};
+  const UInt_t s_version = 2;
+  // characters of TUUID::AsString()
+  const unsigned int s_uuid_size = 36;
+
+  void SetBranchProcess(TBranch* branch, bool process){
+    if(process) branch->ResetBit(TBranch::kDoNotProcess);
+    else branch->SetBit(TBranch::kDoNotProcess);
+    TObjArray* branches = branch->GetListOfBranches();
+    for(int i=0; i<branches->GetEntriesFast(); ++i){
+      SetBranchProcess((TBranch*) branches->At(i), process);
+    }
+  }
+}
+
+EventIndex::EventIndex(const char* name)
+  : m_nentries(0), m_reference(0), m_logger(name)
+{
+}
+
+EventIndex::~EventIndex()
+{
+}
+
+std::string EventIndex::IndexFile(const std::string& directory, const std::string& file)
+{
+  // the full path keeps files with equal names in different directories apart
+  std::string name = file;
+  std::replace(name.begin(), name.end(), '/', '_');
+  std::replace(name.begin(), name.end(), ':', '_');
+  return directory + "/" + name + ".evtidx";
+}
+
+std::string EventIndex::FileUUID(TTree* tree)
+{
+  TFile* file = tree ? tree->GetCurrentFile() : 0;
+  if(!file) return std::string(s_uuid_size, ' ');
+  std::string uuid = file->GetUUID().AsString();
+  uuid.resize(s_uuid_size, ' ');
+  return uuid;
+}
+
+bool EventIndex::Build(TTree* tree)
+{
+  m_records.clear();
+  m_nentries = 0;
+  m_uuid = "";
+  if(!tree) return false;
+
+  TLeaf* run = tree->GetLeaf("run");
+  TLeaf* lumi = tree->GetLeaf("luminosityBlock");
+  TLeaf* event = tree->GetLeaf("event");
+  if(!run || !lumi || !event){
+    m_logger << ERROR << "tree " << tree->GetName() << " has no run, luminosityBlock and event branches" << SLogger::endmsg;
+    return false;
+  }
+
+  Long64_t nentries = tree->GetEntries();
+  m_nentries = nentries;
+  m_uuid = FileUUID(tree);
+  m_records.reserve(nentries);
+  for(Long64_t i=0; i<nentries; ++i){
+    run->GetBranch()->GetEntry(i, 1);
+    lumi->GetBranch()->GetEntry(i, 1);
+    event->GetBranch()->GetEntry(i, 1);
+    Record record;
+    record.run = (Int_t) run->GetValue();
+    record.lumi = (Int_t) lumi->GetValue();
+    record.event = (Int_t) event->GetValue();
+    record.entry = i;
+    m_records.push_back(record);
+  }
+  std::stable_sort(m_records.begin(), m_records.end());
+
+  m_logger << INFO << "indexed " << m_records.size() << " entries of " << tree->GetName() << SLogger::endmsg;
+  return true;
+}
+
+bool EventIndex::Save(const std::string& directory, const std::string& file) const
+{
+  std::string filename = IndexFile(directory, file);
+
+  // written under a name of its own, other jobs only see the complete file
+  std::ostringstream tmpname;
+  tmpname << filename << ".tmp" << gSystem->GetPid();
+
+  FILE* out = fopen(tmpname.str().c_str(), "wb");
+  if(!out){
+    m_logger << WARNING << "cannot write event index " << filename << SLogger::endmsg;
+    return false;
+  }
+  UInt_t header[3];
+  memcpy(&header[0], s_magic, sizeof(UInt_t));
+  header[1] = s_version;
+  header[2] = m_records.size();
+  fwrite(header, sizeof(header), 1, out);
+  fwrite(&m_nentries, sizeof(m_nentries), 1, out);
+  fwrite(m_uuid.data(), 1, s_uuid_size, out);
+  if(!m_records.empty()) fwrite(&m_records[0], sizeof(Record), m_records.size(), out);
+  bool ok = !ferror(out);
+  if(fclose(out)!=0) ok = false;
+
+  if(!ok || gSystem->Rename(tmpname.str().c_str(), filename.c_str())!=0){
+    m_logger << WARNING << "cannot write event index " << filename << SLogger::endmsg;
+    gSystem->Unlink(tmpname.str().c_str());
+    return false;
+  }
+  return true;
+}
+
+bool EventIndex::Load(const std::string& directory, const std::string& file, TTree* tree)
+{
+  m_records.clear();
+  m_nentries = 0;
+  m_uuid = "";
+
+  std::string filename = IndexFile(directory, file);
+  FILE* in = fopen(filename.c_str(), "rb");
+  if(!in) return false;
+
+  UInt_t header[3];
+  bool ok = fread(header, sizeof(header), 1, in)==1
+    && memcmp(&header[0], s_magic, sizeof(UInt_t))==0 && header[1]==s_version;
+  char uuid[s_uuid_size];
+  ok = ok && fread(&m_nentries, sizeof(m_nentries), 1, in)==1 && fread(uuid, 1, s_uuid_size, in)==s_uuid_size;
+  if(ok){
+    m_uuid.assign(uuid, s_uuid_size);
+    m_records.resize(header[2]);
+    ok = m_records.empty() || fread(&m_records[0], sizeof(Record), m_records.size(), in)==m_records.size();
+  }
+  fclose(in);
+
+  if(!ok){
+    m_logger << WARNING << "event index " << filename << " is not readable" << SLogger::endmsg;
+    m_records.clear();
+    return false;
+  }
+
+  // a skim regenerated under the same name
+  if(!tree || m_nentries!=tree->GetEntries() || m_uuid!=FileUUID(tree)){
+    m_logger << INFO << "event index " << filename << " was built for another version of " << file
+             << ", building it again" << SLogger::endmsg;
+    m_records.clear();
+    return false;
+  }
+  return true;
+}
+
+Long64_t EventIndex::Find(int run, int lumi, int event) const
+{
+  Record key;
+  key.run = run;
+  key.lumi = lumi;
+  key.event = event;
+  key.entry = 0;
+  std::vector<Record>::const_iterator it = std::lower_bound(m_records.begin(), m_records.end(), key);
+  if(it==m_records.end() || key<*it) return -1;
+  return it->entry;
+}
+
+bool EventIndex::SkipAll(TTree* tree)
+{
+  m_reference = 0;
+  m_skipped.clear();
+  if(!tree) return false;
+
+  TLeaf* event = tree->GetLeaf("event");
+  if(!event){
+    m_logger << ERROR << "tree " << tree->GetName() << " has no event branch" << SLogger::endmsg;
+    return false;
+  }
+  m_reference = event->GetBranch();
+
+  TObjArray* branches = tree->GetListOfBranches();
+  for(int i=0; i<branches->GetEntriesFast(); ++i){
+    TBranch* branch = (TBranch*) branches->At(i);
+    if(branch->TestBit(TBranch::kDoNotProcess)) continue;
+    m_skipped.push_back(branch);
+    if(branch!=m_reference) SetBranchProcess(branch, false);
+  }
+  return true;
+}
+
+Long64_t EventIndex::CurrentEntry() const
+{
+  return m_reference ? m_reference->GetReadEntry() : -1;
+}
+
+bool EventIndex::ReadEntry(Long64_t entry, const std::set<std::string>& skip)
+{
+  for(unsigned int i=0; i<m_skipped.size(); ++i){
+    TBranch* branch = m_skipped[i];
+    if(branch==m_reference || skip.count(branch->GetName())) continue;
+    if(branch->GetEntry(entry, 1)<0){
+      m_logger << ERROR << "failed to read branch " << branch->GetName() << " for entry " << entry << SLogger::endmsg;
+      return false;
+    }
+  }
+  return true;
+}
+
+void EventIndex::SetProcess(TTree* tree, bool process)
+{
+  if(!tree) return;
+  TObjArray* branches = tree->GetListOfBranches();
+  for(int i=0; i<branches->GetEntriesFast(); ++i){
+    SetBranchProcess((TBranch*) branches->At(i), process);
+  }
+}
@@ -0,0 +1,153 @@
+#include "include/EventListWriter.h"
+
+#include <algorithm>
+#include <fstream>
+
+// ROOT include(s):
+#include <TSystem.h>
+#include <TProofServ.h>
+
+using namespace std;
+
+namespace {
+  const unsigned int s_buffer_records = 8192;
+  const char* s_part = ".part";
+  const char* s_binary = ".bin";
+}
+
+EventListWriter::EventListWriter(const char* name)
+  : m_file(0), m_nevents(0), m_logger(name)
+{
+}
+
+EventListWriter::~EventListWriter()
+{
+  Close();
+}
+
+std::string EventListWriter::ProcessId()
+{
+  if(gProofServ) return gProofServ->GetOrdinal();
+  return "0";
+}
+
+std::string EventListWriter::PartFile(const std::string& basename, const std::string& suffix)
+{
+  return basename + s_part + ProcessId() + suffix;
+}
+
+std::vector<std::string> EventListWriter::PartFiles(const std::string& basename, const std::string& suffix)
+{
+  std::vector<std::string> parts;
+
+  std::string dir = gSystem->DirName(basename.c_str());
+  std::string prefix = std::string(gSystem->BaseName(basename.c_str())) + s_part;
+
+  void* dirp = gSystem->OpenDirectory(dir.c_str());
+  if(!dirp) return parts;
+  const char* entry;
+  while((entry = gSystem->GetDirEntry(dirp))){
+    std::string name = entry;
+    if(name.size()>prefix.size()+suffix.size()
+       && name.compare(0, prefix.size(), prefix)==0
+       && name.compare(name.size()-suffix.size(), suffix.size(), suffix)==0){
+      parts.push_back(dir + "/" + name);
+    }
+  }
+  gSystem->FreeDirectory(dirp);
+  std::sort(parts.begin(), parts.end());
+  return parts;
+}
+
+bool EventListWriter::Open(const std::string& basename)
+{
+  Close();
+  std::string filename = PartFile(basename, s_binary);
+  m_file = fopen(filename.c_str(), "wb");
+  if(!m_file){
+    m_logger << ERROR << "cannot create event list " << filename << SLogger::endmsg;
+    return false;
+  }
+  m_buffer.reserve(s_buffer_records);
+  m_nevents = 0;
+  return true;
+}
+
+void EventListWriter::Add(int run, int lumi, int event, UInt_t categories)
+{
+  if(!m_file) return;
+  Record record;
+  record.run = run;
+  record.lumi = lumi;
+  record.event = event;
+  record.categories = categories;
+  m_buffer.push_back(record);
+  if(m_buffer.size()>=s_buffer_records) Flush();
+}
+
+void EventListWriter::Flush()
+{
+  if(!m_file || m_buffer.empty()) return;
+  if(fwrite(&m_buffer[0], sizeof(Record), m_buffer.size(), m_file)!=m_buffer.size()){
+    m_logger << ERROR << "failed to write " << m_buffer.size() << " events to the event list" << SLogger::endmsg;
+  }
+  m_nevents += m_buffer.size();
+  m_buffer.clear();
+}
+
+void EventListWriter::Close()
+{
+  if(!m_file) return;
+  Flush();
+  fclose(m_file);
+  m_file = 0;
+  m_logger << DEBUG << "wrote " << m_nevents << " events" << SLogger::endmsg;
+}
+
+void EventListWriter::RemoveParts(const std::string& basename)
+{
+  std::vector<std::string> parts = PartFiles(basename);
+  for(unsigned int i=0; i<parts.size(); ++i) gSystem->Unlink(parts[i].c_str());
+}
+
+bool EventListWriter::Merge(const std::string& basename)
+{
+  std::vector<std::string> parts = PartFiles(basename);
+  std::vector<Record> records;
+
+  for(unsigned int i=0; i<parts.size(); ++i){
+    FILE* part = fopen(parts[i].c_str(), "rb");
+    if(!part){
+      m_logger << ERROR << "cannot read event list " << parts[i] << SLogger::endmsg;
+      return false;
+    }
+    Record buffer[1024];
+    size_t n;
+    while((n = fread(buffer, sizeof(Record), 1024, part))>0){
+      records.insert(records.end(), buffer, buffer+n);
+    }
+    fclose(part);
+  }
+
+  std::sort(records.begin(), records.end());
+
+  FILE* binary = fopen((basename + s_binary).c_str(), "wb");
+  if(!binary){
+    m_logger << ERROR << "cannot create event list " << basename << s_binary << SLogger::endmsg;
+    return false;
+  }
+  if(!records.empty()) fwrite(&records[0], sizeof(Record), records.size(), binary);
+  fclose(binary);
+
+  std::ofstream text((basename + ".txt").c_str());
+  for(unsigned int i=0; i<records.size(); ++i){
+    text << records[i].run << ":" << records[i].lumi << ":" << records[i].event << "\n";
+  }
+  text.close();
+
+  for(unsigned int i=0; i<parts.size(); ++i) gSystem->Unlink(parts[i].c_str());
+
+  m_logger << INFO << "merged " << records.size() << " events from " << parts.size()
+           << " part files into " << basename << ".txt" << SLogger::endmsg;
+  return true;
+}
@@ -0,0 +1,63 @@
+#include "include/EventRandom.h"
+
+// ROOT include(s):
+#include <TRandom.h>
+
+EventRandom::EventRandom()
+  : m_enabled(false), m_sample(0), m_saved(false)
+{
+}
+
+EventRandom::~EventRandom()
+{
+}
+
+ULong64_t EventRandom::Mix(ULong64_t x)
+{
+  x += 0x9E3779B97F4A7C15ULL;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+  return x ^ (x >> 31);
+}
+
+void EventRandom::SetSample(const std::string& sample)
+{
+  // FNV-1a of the name
+  m_sample = 0xCBF29CE484222325ULL;
+  for(unsigned int i=0; i<sample.size(); ++i){
+    m_sample ^= (unsigned char) sample[i];
+    m_sample *= 0x100000001B3ULL;
+  }
+}
+
+ULong64_t EventRandom::Seed(int run, int lumi, int event, UInt_t stream) const
+{
+  ULong64_t seed = Mix(m_sample);
+  seed = Mix(seed ^ (UInt_t) run);
+  seed = Mix(seed ^ (UInt_t) lumi);
+  seed = Mix(seed ^ (UInt_t) event);
+  return Mix(seed ^ stream);
+}
+
+void EventRandom::SeedEvent(const BaseCycleContainer* bcc, UInt_t stream) const
+{
+  if(!m_enabled) return;
+
+  ULong64_t seed = Seed(bcc->run, bcc->luminosityBlock, bcc->event, stream);
+  UInt_t seed32 = (UInt_t) (seed ^ (seed >> 32));
+  // TRandom3 takes a seed of 0 from the time
+  gRandom->SetSeed(seed32 ? seed32 : 1);
+}
+
+void EventRandom::SaveState()
+{
+  TRandom3* random = dynamic_cast<TRandom3*>(gRandom);
+  m_saved = random!=0;
+  if(random) m_state = *random;
+}
+
+void EventRandom::RestoreState() const
+{
+  TRandom3* random = dynamic_cast<TRandom3*>(gRandom);
+  if(m_saved && random) *random = m_state;
+}
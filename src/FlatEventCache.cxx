@@ -0,0 +1,311 @@
+#include "include/FlatEventCache.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// ROOT include(s):
+#include <TSystem.h>
+#include <TObjArray.h>
+#include <TList.h>
+#include <TRealData.h>
+#include <TDataMember.h>
+#include <TBranchElement.h>
+#include <TProofServ.h>
+#include <TFile.h>
+
+using namespace std;
+
+namespace {
+  const char s_magic[4] = {'F','L','E','C'};
+  const UInt_t s_version = 2;
+}
+
+FlatEventCache::FlatEventCache(const char* name)
+  : m_tree(0), m_reference(0), m_file_size(0), m_out(0), m_data(0), m_size(0), m_table(0), m_nentries(0),
+    m_ncached(0), m_nmissing(0), m_logger(name)
+{
+}
+
+FlatEventCache::~FlatEventCache()
+{
+  Close();
+  for(unsigned int i=0; i<m_columns.size(); ++i) delete m_columns[i];
+}
+
+std::string FlatEventCache::CacheFile(const std::string& directory, const std::string& file)
+{
+  // the full path keeps files with equal names in different directories apart
+  std::string name = file;
+  std::replace(name.begin(), name.end(), '/', '_');
+  std::replace(name.begin(), name.end(), ':', '_');
+  return directory + "/" + name + ".flatcache";
+}
+
+bool FlatEventCache::IsFlat(TClass* cl)
+{
+  if(!cl || !cl->GetListOfRealData()) return false;
+  // the virtual table pointer is only valid in the process that wrote the object
+  if(cl->ClassProperty() & kClassHasVirtual) return false;
+
+  TIter next(cl->GetListOfRealData());
+  TRealData* rd;
+  while((rd = (TRealData*) next())){
+    TDataMember* dm = rd->GetDataMember();
+    if(!dm || dm->IsaPointer() || dm->IsSTLContainer()) return false;
+    if(dm->IsBasic() || dm->IsEnum()) continue;
+    // embedded object: its members are listed as well, but it must not own memory
+    if(!IsFlat(TClass::GetClass(dm->GetTypeName()))) return false;
+  }
+  return true;
+}
+
+void FlatEventCache::SetProcess(TBranch* branch, bool process)
+{
+  if(process) branch->ResetBit(TBranch::kDoNotProcess);
+  else branch->SetBit(TBranch::kDoNotProcess);
+
+  TObjArray* branches = branch->GetListOfBranches();
+  for(int i=0; i<branches->GetEntriesFast(); ++i){
+    SetProcess((TBranch*) branches->At(i), process);
+  }
+}
+
+void FlatEventCache::FillDescriptor(const Column* column, Descriptor& descriptor) const
+{
+  memset(&descriptor, 0, sizeof(Descriptor));
+  strncpy(descriptor.name, column->Name().c_str(), sizeof(descriptor.name)-1);
+  descriptor.size = column->ObjectSize();
+  descriptor.checksum = column->Class() ? column->Class()->GetCheckSum() : 0;
+}
+
+void FlatEventCache::FillHeader(Header& header, Long64_t nentries, Long64_t table) const
+{
+  memset(&header, 0, sizeof(Header));
+  memcpy(header.magic, s_magic, sizeof(s_magic));
+  header.version = s_version;
+  header.ncolumns = m_active.size();
+  header.nentries = nentries;
+  header.table = table;
+  header.filesize = m_file_size;
+  strncpy(header.uuid, m_file_uuid.c_str(), sizeof(header.uuid)-1);
+}
+
+bool FlatEventCache::Open(const std::string& directory, const std::string& file, TTree* tree)
+{
+  Close();
+  m_tree = tree;
+  m_reference = 0;
+  m_active.clear();
+  if(!tree) return false;
+
+  // the framework reads the branches, not the tree: the entry is taken from a
+  // branch of a basic type (run, event number), which is read for every entry
+  TObjArray* branches = tree->GetListOfBranches();
+  for(int j=0; j<branches->GetEntriesFast() && !m_reference; ++j){
+    TBranch* branch = (TBranch*) branches->At(j);
+    if(branch->GetAddress() && !branch->InheritsFrom(TBranchElement::Class())
+       && !branch->TestBit(TBranch::kDoNotProcess)) m_reference = branch;
+  }
+  if(!m_reference){
+    m_logger << WARNING << "no branch of " << tree->GetName() << " is read for every entry, reading all collections from the tree" << SLogger::endmsg;
+    return false;
+  }
+
+  // the collections connected by the framework, found by the address of their member
+  for(unsigned int i=0; i<m_columns.size(); ++i){
+    Column* column = m_columns[i];
+    column->SetBranch(0);
+    for(int j=0; j<branches->GetEntriesFast(); ++j){
+      TBranch* branch = (TBranch*) branches->At(j);
+      if(branch->GetAddress()==column->Address()) column->SetBranch(branch);
+    }
+    if(!column->Branch()) continue;
+
+    TClass* cl = column->Class();
+    if(!IsFlat(cl) || (UInt_t) cl->Size()!=column->ObjectSize()){
+      m_logger << INFO << column->Name() << " (" << (cl ? cl->GetName() : "unknown class")
+               << ") cannot be stored as raw bytes, reading it from the tree" << SLogger::endmsg;
+      continue;
+    }
+    m_active.push_back(column);
+  }
+  if(m_active.empty()) return false;
+
+  m_filename = CacheFile(directory, file);
+  TFile* input = tree->GetCurrentFile();
+  m_file_uuid = input ? input->GetUUID().AsString() : "";
+  m_file_size = input ? input->GetSize() : 0;
+  if(OpenForReading(tree)) return true;
+
+  // a PROOF worker only processes some of the entries of the file
+  if(gProofServ){
+    m_logger << INFO << "no cache " << m_filename << ", it is written only by local jobs" << SLogger::endmsg;
+    m_active.clear();
+    return false;
+  }
+  return OpenForWriting(tree);
+}
+
+bool FlatEventCache::OpenForReading(TTree* tree)
+{
+  int fd = open(m_filename.c_str(), O_RDONLY);
+  if(fd<0) return false;
+
+  struct stat info;
+  void* data = MAP_FAILED;
+  if(fstat(fd, &info)==0 && (size_t) info.st_size>=sizeof(Header)){
+    data = mmap(0, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+  // the mapping stays valid after closing the descriptor
+  close(fd);
+  if(data==MAP_FAILED) return false;
+
+  m_data = (char*) data;
+  m_size = info.st_size;
+
+  Header header;
+  memcpy(&header, m_data, sizeof(Header));
+  Header current;
+  FillHeader(current, tree->GetEntries(), header.table);
+  bool ok = memcmp(&header, &current, sizeof(Header))==0
+    && sizeof(Header) + header.ncolumns*sizeof(Descriptor)<=m_size
+    && header.table>=0 && (size_t) header.table + header.nentries*sizeof(Long64_t)<=m_size;
+
+  for(unsigned int i=0; ok && i<m_active.size(); ++i){
+    Descriptor expected;
+    FillDescriptor(m_active[i], expected);
+    ok = memcmp(m_data + sizeof(Header) + i*sizeof(Descriptor), &expected, sizeof(Descriptor))==0;
+  }
+
+  if(!ok){
+    m_logger << WARNING << m_filename << " does not match the input, writing it again" << SLogger::endmsg;
+    munmap(m_data, m_size);
+    m_data = 0;
+    m_size = 0;
+    // Close() does not replace an existing cache
+    gSystem->Unlink(m_filename.c_str());
+    return false;
+  }
+
+  m_table = (const Long64_t*) (m_data + header.table);
+  m_nentries = header.nentries;
+  m_ncached = 0;
+  m_nmissing = 0;
+
+  for(unsigned int i=0; i<m_active.size(); ++i) SetProcess(m_active[i]->Branch(), false);
+
+  m_logger << INFO << "reading " << m_active.size() << " collections from " << m_filename << SLogger::endmsg;
+  return true;
+}
+
+bool FlatEventCache::OpenForWriting(TTree* tree)
+{
+  // written under a name of its own, other jobs only see the complete file
+  std::ostringstream tmpname;
+  tmpname << m_filename << ".tmp" << gSystem->GetPid();
+  m_tmpname = tmpname.str();
+
+  m_out = fopen(m_tmpname.c_str(), "wb");
+  if(!m_out){
+    m_logger << WARNING << "cannot create " << m_tmpname << ", reading all collections from the tree" << SLogger::endmsg;
+    return false;
+  }
+
+  Header header;
+  FillHeader(header, tree->GetEntries(), -1);
+  fwrite(&header, sizeof(Header), 1, m_out);
+  for(unsigned int i=0; i<m_active.size(); ++i){
+    Descriptor descriptor;
+    FillDescriptor(m_active[i], descriptor);
+    fwrite(&descriptor, sizeof(Descriptor), 1, m_out);
+  }
+
+  m_offsets.assign(header.nentries, -1);
+  m_ncached = 0;
+  m_nmissing = 0;
+
+  m_logger << INFO << "writing " << m_active.size() << " collections to " << m_filename << SLogger::endmsg;
+  return true;
+}
+
+void FlatEventCache::Load()
+{
+  if(!m_tree || (!m_out && !m_data)) return;
+
+  Long64_t entry = m_reference->GetReadEntry();
+
+  if(m_out){
+    if(entry<0) return;
+    if(entry>=(Long64_t) m_offsets.size()) return;
+    m_offsets[entry] = ftell(m_out);
+    for(unsigned int i=0; i<m_active.size(); ++i) m_active[i]->Write(m_out);
+    ++m_ncached;
+    return;
+  }
+
+  // the cached collections are not read from the tree, they would keep the previous event
+  if(entry<0) throw SError( ("no entry read from " + std::string(m_tree->GetName()) + " before loading "
+                             + m_filename).c_str(), SError::StopExecution );
+
+  if(entry>=m_nentries || m_table[entry]<0){
+    ReadFromTree(entry);
+    ++m_nmissing;
+    return;
+  }
+  const char* data = m_data + m_table[entry];
+  for(unsigned int i=0; i<m_active.size(); ++i) data = m_active[i]->Read(data);
+  ++m_ncached;
+}
+
+void FlatEventCache::ReadFromTree(Long64_t entry)
+{
+  for(unsigned int i=0; i<m_active.size(); ++i){
+    if(m_active[i]->Branch()->GetEntry(entry, 1)<0){
+      m_logger << ERROR << "failed to read branch " << m_active[i]->Branch()->GetName()
+               << " for entry " << entry << SLogger::endmsg;
+      throw SError( SError::SkipEvent );
+    }
+  }
+}
+
+void FlatEventCache::Close()
+{
+  if(m_out){
+    Header header;
+    FillHeader(header, m_offsets.size(), ftell(m_out));
+    if(!m_offsets.empty()) fwrite(&m_offsets[0], sizeof(Long64_t), m_offsets.size(), m_out);
+    fseek(m_out, 0, SEEK_SET);
+    fwrite(&header, sizeof(Header), 1, m_out);
+    bool ok = !ferror(m_out);
+    fclose(m_out);
+    m_out = 0;
+
+    // a cache written by another job in the meantime is kept
+    if(ok && gSystem->AccessPathName(m_filename.c_str()) && gSystem->Rename(m_tmpname.c_str(), m_filename.c_str())==0){
+      m_logger << INFO << "cached " << m_ncached << " of " << m_offsets.size() << " entries in " << m_filename << SLogger::endmsg;
+    } else {
+      if(!ok) m_logger << ERROR << "failed to write " << m_tmpname << SLogger::endmsg;
+      gSystem->Unlink(m_tmpname.c_str());
+    }
+    m_offsets.clear();
+  }
+
+  if(m_data){
+    m_logger << INFO << m_ncached << " entries read from " << m_filename << ", "
+             << m_nmissing << " from the tree" << SLogger::endmsg;
+    munmap(m_data, m_size);
+    m_data = 0;
+    m_size = 0;
+    m_table = 0;
+    m_nentries = 0;
+  }
+
+  // the branches of the tree are not touched, it may already be deleted with its file
+  m_tree = 0;
+  m_reference = 0;
+}
@@ -4,6 +4,7 @@ using namespace std;
 
 // Local include(s):
 #include "include/GenTTbarCycle.h"
+#include "include/HistogramOnlyMode.h"
 
 ClassImp( GenTTbarCycle );
 
@@ -16,11 +17,23 @@ GenTTbarCycle::GenTTbarCycle()
   // set the integrated luminosity per bin for the lumi-yield control plots
   SetIntLumiPerBin(500.);
 
+  // switch off the input branches not used in the first BranchUsageLearnEvents events (0: read all)
+  m_branch_usage_learn_events = 0;
+  m_branch_usage_keep = "";
+  DeclareProperty( "BranchUsageLearnEvents", m_branch_usage_learn_events );
+  DeclareProperty( "BranchUsageKeep", m_branch_usage_keep );
+  m_branch_usage = new BranchUsageTracker("BranchUsageTracker");
+
+  // histograms only: no output tree may be configured for the InputData, nothing is written per event
+  m_histogram_only = false;
+  DeclareProperty( "HistogramOnly", m_histogram_only );
+
 }
 
 GenTTbarCycle::~GenTTbarCycle() 
 {
   // destructor
+  delete m_branch_usage;
 }
 
 void GenTTbarCycle::BeginCycle() throw( SError ) 
@@ -51,9 +64,14 @@ void GenTTbarCycle::BeginInputData( const SInputData& id ) throw( SError )
 {
   // declaration of histograms and selections
 
+  if(m_histogram_only) HistogramOnlyMode::Check( id );
+
   // Important: first call BeginInputData of base class
   AnalysisCycle::BeginInputData( id );
 
+  m_branch_usage->Configure(m_branch_usage_learn_events);
+  m_branch_usage->RequireBranches(m_branch_usage_keep);
+
   // -------------------- set up the selections ---------------------------
 
 
@@ -77,6 +95,9 @@ void GenTTbarCycle::BeginInputData( const SInputData& id ) throw( SError )
   // important: initialise histogram collections after their definition
   InitHistos();
 
+  // selections used in ExecuteEvent
+  m_mtt_selection = GetSelection("mtt_selection");
+
   return;
 
 }
@@ -84,6 +105,7 @@ void GenTTbarCycle::BeginInputData( const SInputData& id ) throw( SError )
 void GenTTbarCycle::EndInputData( const SInputData& id ) throw( SError ) 
 {
   AnalysisCycle::EndInputData( id );
+  m_branch_usage->PrintStatistics();
   return;
 
 }
@@ -96,6 +118,13 @@ void GenTTbarCycle::BeginInputFile( const SInputData& id ) throw( SError )
   // important: call to base function to connect all variables to Ntuples from the input tree
   AnalysisCycle::BeginInputFile( id );
 
+  // the generator particles are used by MttbarGenCut and the ttbar generator info of the histograms
+  if(m_branch_usage->IsActive()){
+    BaseCycleContainer* bcc = EventCalc::Instance()->GetBaseCycleContainer();
+    m_branch_usage->Require(&bcc->genparticles);
+    m_branch_usage->Setup(GetInputTree("AnalysisTree"));
+  }
+
   return;
 
 }
@@ -105,6 +134,8 @@ void GenTTbarCycle::ExecuteEvent( const SInputData& id, Double_t weight) throw(
   // this is the most important part: here the full analysis happens
   // user should implement selections, filling of histograms and results
 
+  m_branch_usage->Update();
+
   // first step: call Execute event of base class to perform basic consistency checks
   // also, the good-run selection is performed there and the calculator is reset
   AnalysisCycle::ExecuteEvent( id, weight );
@@ -117,8 +148,7 @@ void GenTTbarCycle::ExecuteEvent( const SInputData& id, Double_t weight) throw(
 //   return;
 
   // get the selections
-  static Selection* mtt_selection = GetSelection("mtt_selection");
-  if(!mtt_selection->passSelection())  throw SError( SError::SkipEvent );
+  if(!m_mtt_selection->passSelection())  throw SError( SError::SkipEvent );
 
 
   // get the histogram collections
@@ -126,21 +156,22 @@ void GenTTbarCycle::ExecuteEvent( const SInputData& id, Double_t weight) throw(
   HistsNoCuts->Fill();
 
   EventCalc* calc = EventCalc::Instance();
+  std::vector<GenParticle>* genparticles = m_branch_usage->Use(calc->GetBaseCycleContainer()->genparticles);
   //std::cout << calc->GetGenParticles()->at(2).pdgId() << "   " << calc->GetGenParticles()->at(3).pdgId() << std::endl;
-  if( abs(calc->GetGenParticles()->at(0).pdgId())<=5 && abs(calc->GetGenParticles()->at(1).pdgId())<=5 ){
+  if( abs(genparticles->at(0).pdgId())<=5 && abs(genparticles->at(1).pdgId())<=5 ){
     GetHistCollection("quarks")->Fill();
 
     int n_finalstate=0;
-    for(unsigned int i=0; i< calc->GetGenParticles()->size(); ++i){
-      GenParticle p = calc->GetGenParticles()->at(i);
+    for(unsigned int i=0; i< genparticles->size(); ++i){
+      GenParticle p = genparticles->at(i);
       if(p.status()!=3) continue;
-      if(p.daughter(calc->GetGenParticles(),1)){
-	if(p.daughter(calc->GetGenParticles(),1)->status()==3){
+      if(p.daughter(genparticles,1)){
+	if(p.daughter(genparticles,1)->status()==3){
 	  continue;
 	}
       }
-      if(p.daughter(calc->GetGenParticles(),2)){
-	if(p.daughter(calc->GetGenParticles(),2)->status()==3){
+      if(p.daughter(genparticles,2)){
+	if(p.daughter(genparticles,2)->status()==3){
 	  continue;
 	}
       }
@@ -0,0 +1,23 @@
+#include "include/HistogramOnlyMode.h"
+
+#include <string>
+
+// SFrame include(s):
+#include "core/include/STreeType.h"
+#include "core/include/SLogger.h"
+
+void HistogramOnlyMode::Check( const SInputData& id ) throw( SError )
+{
+  std::string trees;
+  const std::vector< STree >* simple = id.GetTrees( STreeType::OutputSimpleTree );
+  const std::vector< STree >* meta = id.GetTrees( STreeType::OutputMetaTree );
+  for(unsigned int i=0; simple && i<simple->size(); ++i) trees += std::string(" ") + (*simple)[i].treeName.Data();
+  for(unsigned int i=0; meta && i<meta->size(); ++i) trees += std::string(" ") + (*meta)[i].treeName.Data();
+
+  if(trees != "")
+    throw SError( ("HistogramOnly is set, but output trees are configured for " + std::string(id.GetType().Data()) + " "
+                   + id.GetVersion().Data() + ":" + trees + " --- remove them from the InputData").c_str(), SError::StopExecution );
+
+  SLogger logger("HistogramOnlyMode");
+  logger << DEBUG << "no output trees for " << id.GetVersion() << ", writing histograms only" << SLogger::endmsg;
+}
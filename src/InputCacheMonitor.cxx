@@ -0,0 +1,98 @@
+#include "include/InputCacheMonitor.h"
+
+// ROOT include(s):
+#include <TEnv.h>
+#include <TFile.h>
+#include <TTreeCache.h>
+
+InputCacheMonitor::InputCacheMonitor(const char* name)
+  : m_tree(0), m_cachesize(0), m_learnentries(100), m_asyncprefetch(false),
+    m_bytes_start(0), m_calls_start(0),
+    m_nfiles(0), m_nevents(0), m_file_events(0), m_cached_events(0),
+    m_efficiency(0.), m_efficiency_rel(0.), m_sum_efficiency(0.), m_sum_efficiency_rel(0.),
+    m_logger(name)
+{
+}
+
+InputCacheMonitor::~InputCacheMonitor()
+{
+}
+
+void InputCacheMonitor::Configure()
+{
+  // read by TFile when a file is opened
+  if(m_asyncprefetch) gEnv->SetValue("TFile.AsyncPrefetching", 1);
+
+  m_tree = 0;
+  m_bytes_start = TFile::GetFileBytesRead();
+  m_calls_start = TFile::GetFileReadCalls();
+  m_nfiles = 0;
+  m_nevents = 0;
+  m_file_events = 0;
+  m_cached_events = 0;
+  m_efficiency = 0.;
+  m_efficiency_rel = 0.;
+  m_sum_efficiency = 0.;
+  m_sum_efficiency_rel = 0.;
+}
+
+void InputCacheMonitor::CommitFile()
+{
+  if(!m_tree) return;
+  m_nevents += m_file_events;
+  if(m_efficiency>0. || m_efficiency_rel>0.){
+    m_cached_events += m_file_events;
+    m_sum_efficiency += m_efficiency*m_file_events;
+    m_sum_efficiency_rel += m_efficiency_rel*m_file_events;
+  }
+  m_file_events = 0;
+  m_efficiency = 0.;
+  m_efficiency_rel = 0.;
+  m_tree = 0;
+}
+
+void InputCacheMonitor::Setup(TTree* tree)
+{
+  CommitFile();
+  m_tree = tree;
+  if(!tree) return;
+  ++m_nfiles;
+
+  if(m_cachesize>0){
+    tree->SetCacheSize(m_cachesize);
+    tree->SetCacheLearnEntries(m_learnentries);
+  }
+}
+
+void InputCacheMonitor::Update()
+{
+  if(!m_tree) return;
+  ++m_file_events;
+
+  TFile* file = m_tree->GetCurrentFile();
+  if(!file) return;
+  TTreeCache* cache = dynamic_cast<TTreeCache*>(file->GetCacheRead(m_tree));
+  if(!cache) return;
+  m_efficiency = cache->GetEfficiency();
+  m_efficiency_rel = cache->GetEfficiencyRel();
+}
+
+void InputCacheMonitor::PrintStatistics()
+{
+  CommitFile();
+
+  Long64_t bytes = TFile::GetFileBytesRead() - m_bytes_start;
+  Int_t calls = TFile::GetFileReadCalls() - m_calls_start;
+
+  m_logger << INFO << "read " << bytes/1024./1024. << " MB in " << calls << " calls ("
+           << (calls ? bytes/1024./calls : 0.) << " kB per call) from " << m_nfiles
+           << " files for " << m_nevents << " events" << SLogger::endmsg;
+  if(m_cached_events){
+    m_logger << INFO << "tree cache: " << 100.*m_sum_efficiency_rel/m_cached_events
+             << "% of the reads served by the cache (hits/(hits+misses)), "
+             << 100.*m_sum_efficiency/m_cached_events << "% of the prefetched buffers used"
+             << SLogger::endmsg;
+  } else {
+    m_logger << INFO << "tree cache: not used" << SLogger::endmsg;
+  }
+}
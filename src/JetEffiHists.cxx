@@ -1,6 +1,7 @@
 #include "include/JetEffiHists.h"
 #include "include/SelectionModules.h"
 #include "include/EventCalc.h"
+#include "include/SortedViewCache.h"
 #include <iostream>
 
 using namespace std;
@@ -75,11 +76,11 @@ void JetEffiHists::Fill()
   std::vector<TopJet>* cajets = calc->GetCAJets();	
 
   
-  if(cajets->size()>0){
-    sort(cajets->begin(),cajets->end(),HigherPt());
-    Hist("leading_jet_pt")->Fill(cajets->at(0).pt(),weight);
-    Hist("leading_jet_phi")->Fill(cajets->at(0).phi(),weight);
-    Hist("leading_jet_eta")->Fill(cajets->at(0).eta(),weight);
+  const IndexView<TopJet>& cajets_pt = SortedViewCache::Instance()->Get(cajets);
+  if(cajets_pt.size()>0){
+    Hist("leading_jet_pt")->Fill(cajets_pt[0].pt(),weight);
+    Hist("leading_jet_phi")->Fill(cajets_pt[0].phi(),weight);
+    Hist("leading_jet_eta")->Fill(cajets_pt[0].eta(),weight);
   }
 
 
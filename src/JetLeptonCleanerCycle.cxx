@@ -17,11 +17,19 @@ JetLeptonCleanerCycle::JetLeptonCleanerCycle()
   // set the integrated luminosity per bin for the lumi-yield control plots
   SetIntLumiPerBin(25.);
 
+  m_jets_checkpoint = new CollectionCheckpoint<Jet>();
+  m_met_checkpoint = new ObjectCheckpoint<MET>();
+
+  m_event_random = new EventRandom();
+  m_event_random->DeclareProperties(*this);
 }
 
 JetLeptonCleanerCycle::~JetLeptonCleanerCycle() 
 {
   // destructor
+  delete m_jets_checkpoint;
+  delete m_met_checkpoint;
+  delete m_event_random;
 }
 
 void JetLeptonCleanerCycle::BeginCycle() throw( SError ) 
@@ -56,6 +64,8 @@ void JetLeptonCleanerCycle::BeginInputData( const SInputData& id ) throw( SError
   // Important: first call BeginInputData of base class
   AnalysisCycle::BeginInputData( id );
 
+  m_event_random->SetSample(id.GetVersion().Data());
+
   // ---------------- set up the histogram collections --------------------
 
   // histograms without any cuts
@@ -102,6 +112,8 @@ void JetLeptonCleanerCycle::ExecuteEvent( const SInputData& id, Double_t weight)
   // this is the most important part: here the full analysis happens
   // user should implement selections, filling of histograms and results
 
+  m_event_random->SeedEvent(EventCalc::Instance()->GetBaseCycleContainer());
+
   // first step: call Execute event of base class to perform basic consistency checks
   // also, the good-run selection is performed there and the calculator is reset
   AnalysisCycle::ExecuteEvent( id, weight);
@@ -115,21 +127,14 @@ void JetLeptonCleanerCycle::ExecuteEvent( const SInputData& id, Double_t weight)
   BaseHists* HistsLeptonCleaning = GetHistCollection("CleanedLeptons");
 
   //save uncleaned jet collection and MET for second step with lepton cuts
-  std::vector<Jet> uncleaned_jets;
-  for(unsigned int i=0; i<bcc->jets->size();++i){
-    uncleaned_jets.push_back(bcc->jets->at(i));
-  }
-  MET uncleaned_met = *bcc->met;
+  m_jets_checkpoint->Save(bcc->jets);
+  m_met_checkpoint->Save(bcc->met);
 
   HistsNoCleaning->Fill();
 
   //fill the uncleaned collections back to bcc
-  bcc->met->set_pt (uncleaned_met.pt());
-  bcc->met->set_phi (uncleaned_met.phi());
-  bcc->jets->clear();
-  for(unsigned int i=0; i<uncleaned_jets.size();++i){
-     bcc->jets->push_back(uncleaned_jets.at(i));
-  }
+  m_met_checkpoint->Restore();
+  m_jets_checkpoint->Restore();
 
   Cleaner cleaner;
   if(bcc->muons) cleaner.MuonCleaner_noIso(35,2.1);
@@ -71,28 +71,20 @@ void JetLeptonCleanerHists::Fill()
   BaseCycleContainer* bcc = calc->GetBaseCycleContainer();
   
 
-  Cleaner* cleaner = new Cleaner(bcc);
+  m_arena.Reset();
+  Cleaner* cleaner = m_arena.NewCleaner(bcc);
 
-  std::vector<Jet> original_jets;
-  for(unsigned int i=0; i< bcc->jets->size();++i){
-    original_jets.push_back(bcc->jets->at(i));
-  }
+  m_jets_checkpoint.Save(bcc->jets);
 
   cleaner->JetRecorrector(m_corrector,false);
   cleaner->JetEnergyResolutionShifter(false);
 
-  std::vector<Jet> uncleaned_jets;
-  for(unsigned int i=0; i< bcc->jets->size();++i){
-    uncleaned_jets.push_back(bcc->jets->at(i));
-  }
-
   float uncleanedmet = bcc->met->pt();
 
-  //fill back the original jets and perform lepton subtraction
-  bcc->jets->clear();
-  for(unsigned int i=0; i<original_jets.size();++i){
-     bcc->jets->push_back(original_jets.at(i));
-  }
+  //fill back the original jets and perform lepton subtraction,
+  //the recorrected jets are kept by the checkpoint
+  m_jets_checkpoint.Restore();
+  const std::vector<Jet>& uncleaned_jets = m_jets_checkpoint.Displaced();
 
   cleaner->JetLeptonSubtractor(m_corrector,false);
   cleaner->JetEnergyResolutionShifter(false);
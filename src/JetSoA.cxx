@@ -0,0 +1,122 @@
+#include "include/JetSoA.h"
+#include "include/EventContext.h"
+#include "include/EventCalc.h"
+#include "include/Utils.h"
+
+#include <cmath>
+
+JetSoA::JetSoA()
+  : m_collection(0), m_data(0), m_run(-1), m_event(-1)
+{
+}
+
+const JetSoA& JetSoA::Jets(const std::vector<Jet>* jets)
+{
+  JetSoA& soa = EventContext::Instance()->Jets();
+  if(!soa.Matches(jets)) soa.Fill(jets);
+  return soa;
+}
+
+const JetSoA& JetSoA::TopJets(const std::vector<TopJet>* topjets)
+{
+  JetSoA& soa = EventContext::Instance()->TopJets();
+  if(!soa.Matches(topjets)) soa.Fill(topjets);
+  return soa;
+}
+
+void JetSoA::Fill(const std::vector<Jet>* jets)
+{
+  FillFrom(jets);
+}
+
+void JetSoA::Fill(const std::vector<TopJet>* topjets)
+{
+  FillFrom(topjets);
+}
+
+template<typename T>
+bool JetSoA::Matches(const std::vector<T>* collection) const
+{
+  BaseCycleContainer* bcc = EventCalc::Instance()->GetBaseCycleContainer();
+  if(collection!=m_collection || bcc->run!=m_run || bcc->event!=m_event) return false;
+
+  unsigned int n = collection ? collection->size() : 0;
+  if(n!=size()) return false;
+  return (n ? (const void*) &(*collection)[0] : 0) == m_data;
+}
+
+template<typename T>
+void JetSoA::FillFrom(const std::vector<T>* collection)
+{
+  BaseCycleContainer* bcc = EventCalc::Instance()->GetBaseCycleContainer();
+  m_collection = collection;
+  m_run = bcc->run;
+  m_event = bcc->event;
+
+  unsigned int n = collection ? collection->size() : 0;
+  m_data = n ? (const void*) &(*collection)[0] : 0;
+
+  m_pt.resize(n);
+  m_eta.resize(n);
+  m_phi.resize(n);
+  m_energy.resize(n);
+  m_csv.resize(n);
+  m_flags.resize(n);
+
+  for(unsigned int i=0; i<n; ++i){
+    const T& jet = (*collection)[i];
+    m_pt[i] = jet.pt();
+    m_eta[i] = jet.eta();
+    m_phi[i] = jet.phi();
+    m_energy[i] = jet.energy();
+    m_csv[i] = jet.btag_combinedSecondaryVertex();
+    m_flags[i] = jet.has_genjet() ? e_GenJet : 0;
+  }
+}
+
+double JetSoA::DeltaPhi(unsigned int i, const Particle& p) const
+{
+  double deltaphi = fabs(m_phi[i] - p.phi());
+  if(deltaphi > PI) deltaphi = 2*PI - deltaphi;
+  return deltaphi;
+}
+
+double JetSoA::DeltaR(unsigned int i, const Particle& p) const
+{
+  double deltaeta = m_eta[i] - p.eta();
+  double deltaphi = DeltaPhi(i, p);
+  return sqrt(deltaeta*deltaeta + deltaphi*deltaphi);
+}
+
+int JetSoA::NearestIndex(const Particle& p) const
+{
+  const float ppt = p.pt();
+  double deltarmin = double_infinity();
+  int nearest = -1;
+  for(unsigned int i=0; i<m_pt.size(); ++i){
+    double dr = DeltaR(i, p);
+    if(dr < deltarmin && m_pt[i]!=ppt){
+      deltarmin = dr;
+      nearest = i;
+    }
+  }
+  return nearest;
+}
+
+double JetSoA::HT(double ptmin) const
+{
+  double ht = 0;
+  for(unsigned int i=0; i<m_pt.size(); ++i){
+    ht += (m_pt[i] > ptmin) ? m_pt[i] : 0.f;
+  }
+  return ht;
+}
+
+int JetSoA::NBTags(float cut) const
+{
+  int nbtags = 0;
+  for(unsigned int i=0; i<m_csv.size(); ++i){
+    nbtags += (m_csv[i] > cut) ? 1 : 0;
+  }
+  return nbtags;
+}
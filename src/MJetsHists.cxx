@@ -2,13 +2,32 @@
 #include "include/SelectionModules.h"
 #include "include/TopFitCalc.h"
 #include "include/Utils.h"
+#include "include/SortedViewCache.h"
+#include "include/JetSoA.h"
 #include "TH3F.h"
+#include "TVector3.h"
 #include <iostream>
 #include <cmath>
 #include <stdio.h>
 
 using namespace std;
 
+namespace {
+
+  // pTrel with respect to the jet at index next, which is the nearest jet to p,
+  // as pTrel(p,jets) without scanning the jets again
+  double pTrelNextJet(Particle* p, std::vector<Jet>* jets, int next){
+    if(next<0) return pTrel(p,jets);
+    const Jet& jet = jets->at(next);
+    TVector3 p3(p->v4().Px(),p->v4().Py(),p->v4().Pz());
+    TVector3 jet3(jet.v4().Px(),jet.v4().Py(),jet.v4().Pz());
+    if(p3.Mag()==0 || jet3.Mag()==0) return 0;
+    double sin_alpha = (p3.Cross(jet3)).Mag()/p3.Mag()/jet3.Mag();
+    return p3.Mag()*sin_alpha;
+  }
+
+}
+
 MJetsHists::MJetsHists(const char* name, HypothesisDiscriminator *discr, int scalefactor) : BaseHists(name)
 {
   // named default constructor
@@ -403,26 +422,36 @@ void MJetsHists::Fill()
       Hist("isolation"      )->Fill(muon.relIso(),weight);
       Hist("isolation_ly"   )->Fill(muon.relIso(),weight);
 
-      Hist("muon_nearJet_pTrel")->Fill(pTrel(&muon,antikjets),weight);
-      Hist("muon_nearJet_pTrel_ly")->Fill(pTrel(&muon,antikjets),weight);
+      // nearest jets to muon and neutrino from one scan over the SoA view each
+      const JetSoA& antikjets_soa = JetSoA::Jets(antikjets);
+      int next_muon = antikjets_soa.NearestIndex(muon);
+      int next_neutrino = antikjets_soa.NearestIndex(neutrino_particle);
+
+      double delR_muon = next_muon>=0 ? muon.deltaR(antikjets->at(next_muon)) : deltaRmin(&muon,antikjets);
+      double delR_neutrino = next_neutrino>=0 ? neutrino_particle.deltaR(antikjets->at(next_neutrino)) : deltaRmin(&neutrino_particle,antikjets);
+      double pTrel_muon = pTrelNextJet(&muon,antikjets,next_muon);
+      double pTrel_neutrino = pTrelNextJet(&neutrino_particle,antikjets,next_neutrino);
+
+      Hist("muon_nearJet_pTrel")->Fill(pTrel_muon,weight);
+      Hist("muon_nearJet_pTrel_ly")->Fill(pTrel_muon,weight);
   
       //Hist("TwoDCut")->Fill(deltaRmin(&muon,antikjets),pTrel(&muon,antikjets ));
 
-      Hist("delR_Iso")->Fill(deltaRmin(&muon,antikjets),muon.relIso());
-      ((TH2F*)Hist("delR_pTrel"))->Fill(deltaRmin(&muon,antikjets),pTrel(&muon,antikjets),weight);
-      Hist("Iso_pTrel")->Fill(muon.relIso(),pTrel(&muon,antikjets));
-      Hist("Iso_pTnearJet")->Fill(muon.relIso(),nextJet(&muon,antikjets)->pt());
+      Hist("delR_Iso")->Fill(delR_muon,muon.relIso());
+      ((TH2F*)Hist("delR_pTrel"))->Fill(delR_muon,pTrel_muon,weight);
+      Hist("Iso_pTrel")->Fill(muon.relIso(),pTrel_muon);
+      Hist("Iso_pTnearJet")->Fill(muon.relIso(),next_muon>=0 ? antikjets->at(next_muon).pt() : nextJet(&muon,antikjets)->pt());
   
-      Hist("neutrino_delR_pTrel")->Fill(deltaRmin(&neutrino_particle,antikjets),pTrel(&neutrino_particle,antikjets));
+      Hist("neutrino_delR_pTrel")->Fill(delR_neutrino,pTrel_neutrino);
 
-      Hist("muon_neutrino_delR_pTrel")->Fill(deltaRmin(&muon,antikjets),pTrel(&neutrino_particle,antikjets));
-      Hist("neutrino_muon_delR_pTrel")->Fill(deltaRmin(&neutrino_particle,antikjets),pTrel(&muon,antikjets));
+      Hist("muon_neutrino_delR_pTrel")->Fill(delR_muon,pTrel_neutrino);
+      Hist("neutrino_muon_delR_pTrel")->Fill(delR_neutrino,pTrel_muon);
 
       //((TH3F*) Hist("neutrino_delR_pTrel_eta"))->Fill(deltaRmin(&neutrino_particle,antikjets),pTrel(&neutrino_particle,antikjets),neutrino_particle.eta());
       //((TH3F*) Hist("neutrino_delR_pTrel_phi"))->Fill(deltaRmin(&neutrino_particle,antikjets),pTrel(&neutrino_particle,antikjets),neutrino_particle.phi());
 
-      Hist("neutrino_delR_pTnearJet")->Fill(deltaRmin(&neutrino_particle,antikjets),nextJet(&neutrino_particle,antikjets)->pt());
-      Hist("neutrino_delR_pT")->Fill(deltaRmin(&neutrino_particle,antikjets),neutrino_particle.pt());
+      Hist("neutrino_delR_pTnearJet")->Fill(delR_neutrino,next_neutrino>=0 ? antikjets->at(next_neutrino).pt() : nextJet(&neutrino_particle,antikjets)->pt());
+      Hist("neutrino_delR_pT")->Fill(delR_neutrino,neutrino_particle.pt());
 
 
 
@@ -438,7 +467,7 @@ void MJetsHists::Fill()
       Hist("number_Jets_ly")->Fill(NJets,weight);
       Hist("number_Jets"   )->Fill(NJets,weight);
       
-      if(antikjets)
+      if(antikjets && antikjets_soa.size()>0)
 	{
 	  Particle wboson;
 	  wboson.set_v4(hyp->wlep_v4());
@@ -463,27 +492,27 @@ void MJetsHists::Fill()
 	  Hist("wboson_mass_ly"  )->Fill(sqrt(wboson.v4().M2()),weight);
 	  Hist("wboson_mass"     )->Fill(sqrt(wboson.v4().M2()),weight);
 
-	  double mjets_delphi = wboson.deltaPhi(antikjets->at(0));
-	  double mjets_delR = wboson.deltaR(antikjets->at(0)); 
+	  double mjets_delphi = antikjets_soa.DeltaPhi(0,wboson);
+	  double mjets_delR = antikjets_soa.DeltaR(0,wboson); 
 	  int bjetposi_delphi = 0;
 	  unsigned int bjetposi_delR = 0;
 
 	
 
-	  for(unsigned int j=0; j<antikjets->size(); ++j)
+	  for(unsigned int j=0; j<antikjets_soa.size(); ++j)
 	    {
-	      Jet jet = antikjets->at(j);
-	      
+	      double delphi = antikjets_soa.DeltaPhi(j,wboson);
+	      double delR = antikjets_soa.DeltaR(j,wboson);
  
-	      if(mjets_delphi > wboson.deltaPhi(jet)) 
+	      if(mjets_delphi > delphi) 
 		{
-		  mjets_delphi = wboson.deltaPhi(jet);
+		  mjets_delphi = delphi;
 		  bjetposi_delphi = j;
 		}
 
-	      if(mjets_delR > wboson.deltaR(jet))
+	      if(mjets_delR > delR)
 		{
-		  mjets_delR = wboson.deltaR(jet);
+		  mjets_delR = delR;
 		  bjetposi_delR = j;
 		}	    
 
@@ -862,13 +891,15 @@ void MJetsHists::Fill()
 
       }
   
-  sort(antikjets->begin(),antikjets->end(),HigherPt());
+  // leading jets from the cached pt-ordered views, the event content is not sorted
+  SortedViewCache* views = SortedViewCache::Instance();
+  const IndexView<Jet>& antikjets_pt = views->Get(antikjets);
   
   for (unsigned int i = 0; i<3; i++)
     {
-      if(unsigned(antikjets->size())>i){
+      if(antikjets_pt.size()>i){
 	TString hname = TString::Format("ak_pt%d", i+1);
-	Hist(hname)->Fill(antikjets->at(i).pt(),weight);
+	Hist(hname)->Fill(antikjets_pt[i].pt(),weight);
       }
     }
   
@@ -876,15 +907,15 @@ void MJetsHists::Fill()
     Hist("ak_pt")->Fill(antikjets->at(i).pt(),weight);
   
 
-  sort(cajets->begin(),cajets->end(),HigherPt());
+  const IndexView<TopJet>& cajets_pt = views->Get(cajets);
       
   for (unsigned int i = 0; i<4; i++)
     {
       if( unsigned(NCAJets) > i)
 	{
 	  
-	  TopJet CAJet =  cajets->at(i); 
-	  if(bcc->muons->at(0).phi() == CAJet.phi()) CAJet.set_v4(cajets->at(i).v4()-bcc->muons->at(0).v4()); 
+	  TopJet CAJet =  cajets_pt[i]; 
+	  if(bcc->muons->at(0).phi() == CAJet.phi()) CAJet.set_v4(cajets_pt[i].v4()-bcc->muons->at(0).v4()); 
 	  
 	  TString hname = TString::Format("ca_pt%d", i+1);
 	  Hist(hname)->Fill(CAJet.pt(),weight);
@@ -76,7 +76,7 @@ float relIsoParticleTree( Particle mu, float deltaR ){
 
 
 
-MetaTreeFiller::MetaTreeFiller(const char* name,  HypothesisDiscriminator *discr, TTree* MetaOutputTree) : BaseHists(name), m_tree(MetaOutputTree)
+MetaTreeFiller::MetaTreeFiller(const char* name,  HypothesisDiscriminator *discr, TreeWriter* writer) : BaseHists(name), m_writer(writer)
 {
   // named default constructor
   m_discr = discr;
@@ -90,33 +90,33 @@ MetaTreeFiller::~MetaTreeFiller()
 void MetaTreeFiller::Init()
 {
   
-  //book output tree branches
+  //book output tree columns
   
   //m_tree->Branch("data");
   
-  m_tree->Branch("weight"    , &m_weight     , "weight/D");
-  m_tree->Branch("pT_mu"     , &m_pT_mu      , "pT_mu/D");
-  m_tree->Branch("HT"        , &m_HT         , "HT/D");
-  m_tree->Branch("2D"        , &m_2D         , "2D/D");
-  m_tree->Branch("mtt"       , &m_mtt        , "mtt/D");
-  m_tree->Branch("met_pt"    , &m_met_pt     , "met_pt/D");
-  m_tree->Branch("Jet_pt_max", &m_Jet_pt_max , "Jet_pt_max/D");
-  m_tree->Branch("btag"      , &m_btag       , "btag/D");
-
-
-  m_tree->Branch("Iso02"   , &m_Iso02   , "Iso02/D");
-  m_tree->Branch("Iso018"  , &m_Iso018  , "Iso018/D");
-  m_tree->Branch("Iso016"  , &m_Iso016  , "Iso016/D");
-  m_tree->Branch("Iso014"  , &m_Iso014  , "Iso014/D");
-  m_tree->Branch("Iso012"  , &m_Iso012  , "Iso012/D");
-  m_tree->Branch("Iso01"   , &m_Iso01   , "Iso01/D");
-  m_tree->Branch("Iso008"  , &m_Iso008  , "Iso008/D");
-  m_tree->Branch("Iso006"  , &m_Iso006  , "Iso006/D");
-  m_tree->Branch("Iso004"  , &m_Iso004  , "Iso004/D");
-  m_tree->Branch("Iso002"  , &m_Iso002  , "Iso002/D");
-
-  m_tree->Branch("Iso04"   , &m_Iso04   , "Iso04/D");
-  m_tree->Branch("Iso05"   , &m_Iso05   , "Iso05/D");
+  m_weight     = m_writer->AddFloat("weight");
+  m_pT_mu      = m_writer->AddFloat("pT_mu");
+  m_HT         = m_writer->AddFloat("HT");
+  m_2D         = m_writer->AddBool ("2D");
+  m_mtt        = m_writer->AddFloat("mtt");
+  m_met_pt     = m_writer->AddFloat("met_pt");
+  m_Jet_pt_max = m_writer->AddFloat("Jet_pt_max");
+  m_btag       = m_writer->AddInt  ("btag");
+
+
+  m_Iso02      = m_writer->AddFloat("Iso02");
+  m_Iso018     = m_writer->AddFloat("Iso018");
+  m_Iso016     = m_writer->AddFloat("Iso016");
+  m_Iso014     = m_writer->AddFloat("Iso014");
+  m_Iso012     = m_writer->AddFloat("Iso012");
+  m_Iso01      = m_writer->AddFloat("Iso01");
+  m_Iso008     = m_writer->AddFloat("Iso008");
+  m_Iso006     = m_writer->AddFloat("Iso006");
+  m_Iso004     = m_writer->AddFloat("Iso004");
+  m_Iso002     = m_writer->AddFloat("Iso002");
+
+  m_Iso04      = m_writer->AddFloat("Iso04");
+  m_Iso05      = m_writer->AddFloat("Iso05");
 }
 
 void MetaTreeFiller::Fill()
@@ -168,41 +168,41 @@ void MetaTreeFiller::Fill()
 
   int Nmuons = muons->size();
 
-  m_weight= weight;
-  m_pT_mu = muon.pt(); 
-  m_HT    = HT;
+  *m_weight= weight;
+  *m_pT_mu = muon.pt(); 
+  *m_HT    = HT;
 
   if(deltaRmin(&muon, antikjets)<0.5 && pTrel(&muon, antikjets)<25)
-    m_2D = 0.;
+    *m_2D = false;
   else 
-    m_2D = 1.;
+    *m_2D = true;
 
-  m_mtt =  (toplep+tophad).isTimelike()?(toplep+tophad).M(): -sqrt((toplep+tophad).M2()) ;
+  *m_mtt =  (toplep+tophad).isTimelike()?(toplep+tophad).M(): -sqrt((toplep+tophad).M2()) ;
  
-  m_met_pt = met->pt();
-  m_Jet_pt_max = antikjets->at(0).pt();
+  *m_met_pt = met->pt();
+  *m_Jet_pt_max = antikjets->at(0).pt();
 
-  m_Iso05  = IsoMuonTree(muon,0.5); 
-  m_Iso04  = IsoMuonTree(muon,0.4);  
+  *m_Iso05  = IsoMuonTree(muon,0.5); 
+  *m_Iso04  = IsoMuonTree(muon,0.4);  
  
-  m_Iso02  = IsoMuonTree(muon,0.2); 
-  m_Iso018 = IsoMuonTree(muon,0.18); 
-  m_Iso016 = IsoMuonTree(muon,0.16); 
-  m_Iso014 = IsoMuonTree(muon,0.14); 
-  m_Iso012 = IsoMuonTree(muon,0.12);  
-  m_Iso01  = IsoMuonTree(muon,0.1);  
-  m_Iso008 = IsoMuonTree(muon,0.08); 
-  m_Iso006 = IsoMuonTree(muon,0.06); 
-  m_Iso004 = IsoMuonTree(muon,0.04); 
-  m_Iso002 = IsoMuonTree(muon,0.02);  
+  *m_Iso02  = IsoMuonTree(muon,0.2); 
+  *m_Iso018 = IsoMuonTree(muon,0.18); 
+  *m_Iso016 = IsoMuonTree(muon,0.16); 
+  *m_Iso014 = IsoMuonTree(muon,0.14); 
+  *m_Iso012 = IsoMuonTree(muon,0.12);  
+  *m_Iso01  = IsoMuonTree(muon,0.1);  
+  *m_Iso008 = IsoMuonTree(muon,0.08); 
+  *m_Iso006 = IsoMuonTree(muon,0.06); 
+  *m_Iso004 = IsoMuonTree(muon,0.04); 
+  *m_Iso002 = IsoMuonTree(muon,0.02);  
  
 
-  m_btag = 0; 
+  *m_btag = 0; 
 
   for(int i= 0; i<antikjets->size(); ++i)
-    if(IsTagged(antikjets->at(i),e_CSVT)) m_btag += 1; 
+    if(IsTagged(antikjets->at(i),e_CSVT)) *m_btag += 1; 
 
-  m_tree->Fill();
+  m_writer->Touch();
   
 
  
@@ -0,0 +1,130 @@
+#include "include/OutputPolicy.h"
+
+#include <sstream>
+#include <cstdlib>
+#include <cctype>
+#include <algorithm>
+
+// ROOT include(s):
+#include <Compression.h>
+#include <RVersion.h>
+#include <TFile.h>
+#include <TObjArray.h>
+
+using namespace std;
+
+OutputPolicy::OutputPolicy(const char* name)
+  : m_compression(-1), m_default_precision(-1), m_pack_flags(false), m_logger(name)
+{
+}
+
+OutputPolicy::~OutputPolicy()
+{
+}
+
+bool OutputPolicy::SetCompression(const std::string& setting)
+{
+  m_compression = -1;
+  if(setting.empty()) return true;
+
+  std::string algorithm = setting.substr(0, setting.find(':'));
+  std::transform(algorithm.begin(), algorithm.end(), algorithm.begin(), ::toupper);
+  int level = 1;
+  if(setting.find(':')!=std::string::npos) level = atoi(setting.substr(setting.find(':')+1).c_str());
+  if(level<0 || level>9){
+    m_logger << ERROR << "compression level " << level << " out of range 0-9" << SLogger::endmsg;
+    return false;
+  }
+
+  if(algorithm=="ZLIB"){
+    m_compression = ROOT::CompressionSettings(ROOT::kZLIB, level);
+  } else if(algorithm=="LZMA"){
+    m_compression = ROOT::CompressionSettings(ROOT::kLZMA, level);
+  } else if(algorithm=="LZ4"){
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,12,0)
+    m_compression = ROOT::CompressionSettings(ROOT::kLZ4, level);
+#else
+    m_logger << WARNING << "LZ4 needs ROOT 6.12, using ZLIB level 1" << SLogger::endmsg;
+    m_compression = ROOT::CompressionSettings(ROOT::kZLIB, 1);
+#endif
+  } else {
+    m_logger << ERROR << "unknown compression algorithm " << algorithm
+             << " --- should be either `ZLIB`, `LZMA` or `LZ4`" << SLogger::endmsg;
+    return false;
+  }
+  return true;
+}
+
+bool OutputPolicy::SetPrecision(const std::string& setting)
+{
+  m_precision.clear();
+  m_default_precision = -1;
+
+  std::istringstream stream(setting);
+  std::string item;
+  while(stream >> item){
+    size_t colon = item.rfind(':');
+    if(colon==std::string::npos || colon==0){
+      m_logger << ERROR << "precision setting " << item << " should be `column:bits`" << SLogger::endmsg;
+      return false;
+    }
+    int bits = atoi(item.substr(colon+1).c_str());
+    if(bits<0 || bits>23){
+      m_logger << ERROR << "mantissa bits of " << item << " out of range 0-23" << SLogger::endmsg;
+      return false;
+    }
+    std::string column = item.substr(0, colon);
+    if(column=="*") m_default_precision = bits;
+    else m_precision[column] = bits;
+  }
+  return true;
+}
+
+int OutputPolicy::PrecisionBits(const std::string& column) const
+{
+  std::map<std::string, int>::const_iterator it = m_precision.find(column);
+  if(it!=m_precision.end()) return it->second;
+  return m_default_precision;
+}
+
+void OutputPolicy::SetBranchCompression(TBranch* branch)
+{
+  branch->SetCompressionSettings(m_compression);
+  TObjArray* branches = branch->GetListOfBranches();
+  for(int i=0; i<branches->GetEntriesFast(); ++i){
+    SetBranchCompression((TBranch*) branches->At(i));
+  }
+}
+
+void OutputPolicy::Apply(TTree* tree)
+{
+  if(!tree || m_compression<0) return;
+
+  // new branches take the setting of the file
+  TFile* file = tree->GetCurrentFile();
+  if(file) file->SetCompressionSettings(m_compression);
+
+  TObjArray* branches = tree->GetListOfBranches();
+  for(int i=0; i<branches->GetEntriesFast(); ++i){
+    SetBranchCompression((TBranch*) branches->At(i));
+  }
+
+  m_logger << DEBUG << "compression settings " << m_compression << " for tree "
+           << tree->GetName() << SLogger::endmsg;
+}
+
+Float_t OutputPolicy::Truncate(Float_t value, int bits)
+{
+  if(bits<0 || bits>=23) return value;
+
+  union { Float_t f; UInt_t u; } b;
+  b.f = value;
+  // infinity and NaN
+  if(((b.u >> 23) & 0xff)==0xff) return value;
+
+  // round half away from zero, a carry into the exponent is the correct result
+  UInt_t drop = 23 - bits;
+  b.u += 1u << (drop - 1);
+  b.u &= ~((1u << drop) - 1);
+  return b.f;
+}
@@ -0,0 +1,419 @@
+#include "include/PDFWeightColumns.h"
+#include "include/EventListWriter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+
+// ROOT include(s):
+#include <TSystem.h>
+
+using namespace std;
+
+namespace {
+  const char s_magic[4] = {'P','D','F','W'};
+  const UInt_t s_version = 2;
+  const UInt_t s_header_size = 4*sizeof(UInt_t);
+  const UInt_t s_block_records = 4096;
+  const char* s_suffix = ".pdfw";
+}
+
+PDFWeightColumns::PDFWeightColumns(const char* name)
+  : m_nmembers(0), m_nrecords(0), m_writing(false),
+    m_block_first(0), m_block_size(0), m_next(0), m_indexed(false),
+    m_nfound(0), m_nindexed(0), m_nmissing(0), m_logger(name)
+{
+}
+
+PDFWeightColumns::~PDFWeightColumns()
+{
+  Close();
+}
+
+bool PDFWeightColumns::OpenForWriting(const std::string& basename)
+{
+  Close();
+  std::string filename = EventListWriter::PartFile(basename, s_suffix);
+  m_out.open(filename.c_str(), ios::out | ios::binary | ios::trunc);
+  if(!m_out.is_open()){
+    m_logger << ERROR << "cannot create " << filename << SLogger::endmsg;
+    return false;
+  }
+  m_writing = true;
+  m_nmembers = 0;
+  m_nrecords = 0;
+  m_nfound = 0;
+  // placeholder, rewritten with the final numbers by Close()
+  WriteHeader();
+  return true;
+}
+
+void PDFWeightColumns::WriteHeader()
+{
+  UInt_t header[4];
+  memcpy(&header[0], s_magic, sizeof(UInt_t));
+  header[1] = s_version;
+  header[2] = m_nmembers;
+  header[3] = m_nrecords;
+  m_out.write((const char*) header, s_header_size);
+}
+
+void PDFWeightColumns::Fill(int run, int lumi, int event, const std::vector<double>& weights)
+{
+  if(!m_writing) return;
+
+  if(m_nrecords==0 && m_nmembers==0) m_nmembers = weights.size();
+  if(weights.size()!=m_nmembers){
+    m_logger << ERROR << "event " << run << ":" << lumi << ":" << event << " has " << weights.size()
+             << " PDF weights instead of " << m_nmembers << ", not stored" << SLogger::endmsg;
+    return;
+  }
+
+  Int_t key[3] = {run, lumi, event};
+  m_halfs.resize(m_nmembers);
+  for(unsigned int i=0; i<m_nmembers; ++i) m_halfs[i] = ToHalf(weights[i]);
+
+  m_out.write((const char*) key, sizeof(key));
+  if(m_nmembers) m_out.write((const char*) &m_halfs[0], m_nmembers*sizeof(UShort_t));
+  ++m_nrecords;
+}
+
+bool PDFWeightColumns::OpenForReading(const std::string& filename)
+{
+  Close();
+  m_in.open(filename.c_str(), ios::in | ios::binary);
+  if(!m_in.is_open()){
+    m_logger << ERROR << "cannot open " << filename << SLogger::endmsg;
+    return false;
+  }
+
+  UInt_t header[4];
+  m_in.read((char*) header, s_header_size);
+  if(!m_in || memcmp(&header[0], s_magic, sizeof(UInt_t))!=0 || header[1]!=s_version){
+    m_logger << ERROR << filename << " is not a PDF weight file of version " << s_version << SLogger::endmsg;
+    m_in.close();
+    return false;
+  }
+  m_nmembers = header[2];
+  m_nrecords = header[3];
+
+  m_block.resize(s_block_records*RecordSize());
+  m_block_first = 0;
+  m_block_size = 0;
+  m_next = 0;
+  m_indexed = false;
+  m_index.clear();
+  m_weights.resize(m_nmembers);
+  m_nfound = 0;
+  m_nindexed = 0;
+  m_nmissing = 0;
+
+  m_logger << INFO << "reading weights of " << m_nmembers << " PDF members for "
+           << m_nrecords << " events from " << filename << SLogger::endmsg;
+  return true;
+}
+
+const char* PDFWeightColumns::Record(UInt_t record)
+{
+  if(record<m_block_first || record>=m_block_first+m_block_size){
+    // blocks start at multiples of s_block_records, see BuildIndex()
+    m_block_first = record - record%s_block_records;
+    m_block_size = min(s_block_records, m_nrecords-m_block_first);
+    m_in.clear();
+    m_in.seekg((streamoff) s_header_size + (streamoff) m_block_first*RecordSize());
+    m_in.read(&m_block[0], (streamsize) m_block_size*RecordSize());
+    if(!m_in){
+      m_logger << ERROR << "failed to read PDF weights of record " << record << SLogger::endmsg;
+      m_block_size = 0;
+      return 0;
+    }
+  }
+  return &m_block[(record-m_block_first)*RecordSize()];
+}
+
+PDFWeightColumns::Key PDFWeightColumns::GetKey(const char* record) const
+{
+  Key key;
+  memcpy(&key.run, record, sizeof(Int_t));
+  memcpy(&key.lumi, record+sizeof(Int_t), sizeof(Int_t));
+  memcpy(&key.event, record+2*sizeof(Int_t), sizeof(Int_t));
+  return key;
+}
+
+void PDFWeightColumns::Decode(const char* record)
+{
+  const char* halfs = record + 3*sizeof(Int_t);
+  for(unsigned int i=0; i<m_nmembers; ++i){
+    UShort_t half;
+    memcpy(&half, halfs+i*sizeof(UShort_t), sizeof(UShort_t));
+    m_weights[i] = FromHalf(half);
+  }
+}
+
+void PDFWeightColumns::SortRecords(std::vector<char>& records) const
+{
+  UInt_t size = RecordSize();
+  std::vector<Position> positions(records.size()/size);
+  for(UInt_t i=0; i<positions.size(); ++i){
+    positions[i].key = GetKey(&records[(size_t) i*size]);
+    positions[i].record = i;
+  }
+  // events processed twice keep their order
+  std::stable_sort(positions.begin(), positions.end());
+
+  std::vector<char> sorted(records.size());
+  for(UInt_t i=0; i<positions.size(); ++i){
+    memcpy(&sorted[(size_t) i*size], &records[(size_t) positions[i].record*size], size);
+  }
+  records.swap(sorted);
+}
+
+void PDFWeightColumns::BuildIndex()
+{
+  m_indexed = true;
+  m_index.clear();
+  for(UInt_t first=0; first<m_nrecords; first+=s_block_records){
+    char key[3*sizeof(Int_t)];
+    m_in.clear();
+    m_in.seekg((streamoff) s_header_size + (streamoff) first*RecordSize());
+    m_in.read(key, sizeof(key));
+    if(!m_in){
+      m_logger << ERROR << "failed to read the key of PDF weight record " << first << SLogger::endmsg;
+      m_index.clear();
+      return;
+    }
+    m_index.push_back(GetKey(key));
+  }
+  m_logger << INFO << "events are not in key order, searching the keys of "
+           << m_index.size() << " blocks" << SLogger::endmsg;
+}
+
+const std::vector<float>* PDFWeightColumns::Find(int run, int lumi, int event)
+{
+  if(!m_in.is_open()) return 0;
+
+  Key key;
+  key.run = run;
+  key.lumi = lumi;
+  key.event = event;
+
+  // events processed in key order are found in the next record
+  if(m_next<m_nrecords){
+    const char* record = Record(m_next);
+    if(record){
+      Key next = GetKey(record);
+      if(!(next<key) && !(key<next)){
+        Decode(record);
+        ++m_next;
+        ++m_nfound;
+        return &m_weights;
+      }
+    }
+  }
+
+  // only the last block starting at or before key can hold it
+  if(!m_indexed) BuildIndex();
+  UInt_t block = std::upper_bound(m_index.begin(), m_index.end(), key) - m_index.begin();
+  UInt_t low = block>0 ? (block-1)*s_block_records : 0;
+  UInt_t end = min(block*s_block_records, m_nrecords);
+  UInt_t high = end;
+  while(low<high){
+    UInt_t middle = low + (high-low)/2;
+    const char* record = Record(middle);
+    if(!record){
+      ++m_nmissing;
+      return 0;
+    }
+    if(GetKey(record)<key) low = middle+1;
+    else high = middle;
+  }
+
+  const char* record = low<end ? Record(low) : 0;
+  if(!record || key<GetKey(record)){
+    ++m_nmissing;
+    return 0;
+  }
+  Decode(record);
+  m_next = low+1;
+  ++m_nfound;
+  ++m_nindexed;
+  return &m_weights;
+}
+
+void PDFWeightColumns::Close()
+{
+  if(m_out.is_open()){
+    m_out.seekp(0);
+    WriteHeader();
+    m_out.close();
+  }
+  if(m_in.is_open()) m_in.close();
+  m_writing = false;
+  m_block.clear();
+  m_index.clear();
+}
+
+void PDFWeightColumns::RemoveParts(const std::string& basename)
+{
+  std::vector<std::string> parts = EventListWriter::PartFiles(basename, s_suffix);
+  for(unsigned int i=0; i<parts.size(); ++i) gSystem->Unlink(parts[i].c_str());
+}
+
+bool PDFWeightColumns::Merge(const std::string& basename)
+{
+  Close();
+  std::vector<std::string> parts = EventListWriter::PartFiles(basename, s_suffix);
+  std::string filename = basename + s_suffix;
+
+  // sort the records of every part in place, a part holds the events of one worker
+  m_nmembers = 0;
+  m_nrecords = 0;
+  std::vector<std::string> sorted;
+  std::vector<UInt_t> left;
+  std::vector<char> buffer;
+  for(unsigned int i=0; i<parts.size(); ++i){
+    std::ifstream part(parts[i].c_str(), ios::in | ios::binary);
+    UInt_t header[4];
+    part.read((char*) header, s_header_size);
+    if(!part || memcmp(&header[0], s_magic, sizeof(UInt_t))!=0 || header[1]!=s_version){
+      m_logger << ERROR << parts[i] << " is not a PDF weight file of version " << s_version << SLogger::endmsg;
+      return false;
+    }
+    // parts of workers without events do not know the number of members
+    if(!header[3]) continue;
+    if(!sorted.empty() && header[2]!=m_nmembers){
+      m_logger << ERROR << parts[i] << " has " << header[2] << " PDF members instead of " << m_nmembers << SLogger::endmsg;
+      return false;
+    }
+    m_nmembers = header[2];
+
+    buffer.resize((size_t) header[3]*RecordSize());
+    part.read(&buffer[0], (streamsize) buffer.size());
+    if(!part){
+      m_logger << ERROR << "failed to read the PDF weights of " << parts[i] << SLogger::endmsg;
+      return false;
+    }
+    part.close();
+    SortRecords(buffer);
+
+    std::ofstream out(parts[i].c_str(), ios::out | ios::binary | ios::trunc);
+    out.write((const char*) header, s_header_size);
+    out.write(&buffer[0], (streamsize) buffer.size());
+    out.close();
+    if(!out){
+      m_logger << ERROR << "failed to write the sorted PDF weights of " << parts[i] << SLogger::endmsg;
+      return false;
+    }
+    sorted.push_back(parts[i]);
+    left.push_back(header[3]);
+  }
+  buffer.clear();
+
+  m_out.open(filename.c_str(), ios::out | ios::binary | ios::trunc);
+  if(!m_out.is_open()){
+    m_logger << ERROR << "cannot create " << filename << SLogger::endmsg;
+    return false;
+  }
+  WriteHeader();
+
+  // merge the sorted parts, keeping the next record of every part in memory
+  UInt_t size = RecordSize();
+  std::vector<std::ifstream*> inputs(sorted.size(), 0);
+  std::vector<char> next(sorted.size()*size);
+  bool ok = true;
+  for(unsigned int i=0; ok && i<sorted.size(); ++i){
+    inputs[i] = new std::ifstream(sorted[i].c_str(), ios::in | ios::binary);
+    inputs[i]->seekg((streamoff) s_header_size);
+    ok = !inputs[i]->read(&next[i*size], size).fail();
+  }
+  while(ok){
+    int smallest = -1;
+    for(unsigned int i=0; i<sorted.size(); ++i){
+      if(!left[i]) continue;
+      if(smallest<0 || GetKey(&next[i*size])<GetKey(&next[smallest*size])) smallest = i;
+    }
+    if(smallest<0) break;
+    m_out.write(&next[smallest*size], size);
+    ++m_nrecords;
+    if(--left[smallest]) ok = !inputs[smallest]->read(&next[smallest*size], size).fail();
+  }
+  for(unsigned int i=0; i<inputs.size(); ++i) delete inputs[i];
+
+  m_out.seekp(0);
+  WriteHeader();
+  m_out.close();
+  if(!ok){
+    m_logger << ERROR << "failed to read the sorted PDF weights while merging into " << filename << SLogger::endmsg;
+    gSystem->Unlink(filename.c_str());
+    return false;
+  }
+
+  for(unsigned int i=0; i<parts.size(); ++i) gSystem->Unlink(parts[i].c_str());
+
+  m_logger << INFO << "merged the PDF weights of " << m_nrecords << " events from " << parts.size()
+           << " part files into " << filename << SLogger::endmsg;
+  return true;
+}
+
+void PDFWeightColumns::PrintStatistics()
+{
+  if(m_writing){
+    m_logger << INFO << "wrote weights of " << m_nmembers << " PDF members for "
+             << m_nrecords << " events" << SLogger::endmsg;
+    return;
+  }
+  m_logger << INFO << "found PDF weights for " << m_nfound << " events (" << m_nindexed
+           << " through the index), " << m_nmissing << " events missing" << SLogger::endmsg;
+}
+
+UShort_t PDFWeightColumns::ToHalf(float value)
+{
+  union { float f; UInt_t u; } bits;
+  bits.f = value;
+
+  UInt_t sign = (bits.u >> 16) & 0x8000;
+  UInt_t biased = (bits.u >> 23) & 0xff;
+  UInt_t mantissa = bits.u & 0x7fffff;
+
+  // infinity and NaN
+  if(biased==0xff) return sign | 0x7c00 | (mantissa ? 0x200 : 0);
+
+  int exponent = (int) biased - 127 + 15;
+  if(exponent>=0x1f) return sign | 0x7c00;
+
+  UInt_t half, rest, halfway;
+  if(exponent<=0){
+    // subnormal half
+    if(exponent<-10) return sign;
+    mantissa |= 0x800000;
+    UInt_t shift = 14 - exponent;
+    half = mantissa >> shift;
+    rest = mantissa & ((1u << shift) - 1);
+    halfway = 1u << (shift - 1);
+  } else {
+    half = ((UInt_t) exponent << 10) | (mantissa >> 13);
+    rest = mantissa & 0x1fff;
+    halfway = 0x1000;
+  }
+  // a carry into the exponent gives the correctly rounded result
+  if(rest>halfway || (rest==halfway && (half & 1))) ++half;
+  return sign | half;
+}
+
+float PDFWeightColumns::FromHalf(UShort_t half)
+{
+  UInt_t sign = (UInt_t) (half & 0x8000) << 16;
+  UInt_t exponent = (half >> 10) & 0x1f;
+  UInt_t mantissa = half & 0x3ff;
+
+  union { float f; UInt_t u; } bits;
+  if(exponent==0){
+    bits.f = ldexp((float) mantissa, -24);
+    bits.u |= sign;
+  } else if(exponent==0x1f){
+    bits.u = sign | 0x7f800000 | (mantissa << 13);
+  } else {
+    bits.u = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+  }
+  return bits.f;
+}
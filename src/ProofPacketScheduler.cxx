@@ -0,0 +1,108 @@
+#include "include/ProofPacketScheduler.h"
+
+#include <map>
+
+// ROOT include(s):
+#include <TProof.h>
+#include <TList.h>
+#include <TTree.h>
+#include <TPerfStats.h>
+
+using namespace std;
+
+namespace {
+  // packets of one worker
+  struct WorkerPackets {
+    WorkerPackets() : npackets(0), nevents(0), proctime(0), finished(0) {}
+    unsigned long npackets;
+    Long64_t nevents;
+    double proctime;
+    double finished;
+  };
+}
+
+ProofPacketScheduler::ProofPacketScheduler(const char* name)
+  : m_packet_fraction(0), m_timing(false), m_mergers(-1), m_logger(name)
+{
+}
+
+ProofPacketScheduler::~ProofPacketScheduler()
+{
+}
+
+void ProofPacketScheduler::SetParameters(const std::string& inputdata)
+{
+  m_inputdata = inputdata;
+  m_stopwatch.Start();
+
+  // local job
+  if(!gProof) return;
+
+  // the adaptive packetizer is PROOF's default, only its packet size is set
+  if(m_packet_fraction>0) gProof->SetParameter("PROOF_PacketAsAFraction", (Int_t) m_packet_fraction);
+  else gProof->DeleteParameters("PROOF_PacketAsAFraction");
+
+  if(m_mergers>=0) gProof->SetParameter("PROOF_UseMergers", (Int_t) m_mergers);
+  else gProof->DeleteParameters("PROOF_UseMergers");
+
+  if(m_timing) gProof->SetParameter("PROOF_StatsTrace", "");
+  else gProof->DeleteParameters("PROOF_StatsTrace");
+}
+
+void ProofPacketScheduler::PrintSummary()
+{
+  m_stopwatch.Stop();
+  m_logger << INFO << m_inputdata << " processed in " << m_stopwatch.RealTime() << " s" << SLogger::endmsg;
+
+  if(!gProof || !m_timing || !gProof->GetOutputList()) return;
+
+  TTree* trace = dynamic_cast<TTree*>(gProof->GetOutputList()->FindObject("PROOF_PerfStats"));
+  if(!trace){
+    m_logger << WARNING << "no packets recorded by PROOF for " << m_inputdata << SLogger::endmsg;
+    return;
+  }
+
+  TPerfEvent* event = 0;
+  trace->SetBranchAddress("PerfEvents", &event);
+
+  std::map<std::string, WorkerPackets> workers;
+  unsigned long npackets = 0;
+  Long64_t nevents = 0;
+  double mintime = 0, maxtime = 0, sumtime = 0;
+  double last = 0;
+
+  for(Long64_t i=0; i<trace->GetEntries(); ++i){
+    trace->GetEntry(i);
+    if(event->fType!=TVirtualPerfStats::kPacket) continue;
+
+    double finished = event->fTimeStamp.GetSec() + 1e-9*event->fTimeStamp.GetNanoSec();
+    WorkerPackets& worker = workers[event->fSlaveName.Data()];
+    ++worker.npackets;
+    worker.nevents += event->fEventsProcessed;
+    worker.proctime += event->fProcTime;
+    if(finished>worker.finished) worker.finished = finished;
+    if(finished>last) last = finished;
+
+    if(!npackets || event->fProcTime<mintime) mintime = event->fProcTime;
+    if(event->fProcTime>maxtime) maxtime = event->fProcTime;
+    sumtime += event->fProcTime;
+    nevents += event->fEventsProcessed;
+    ++npackets;
+  }
+  trace->ResetBranchAddresses();
+  delete event;
+
+  if(npackets){
+    m_logger << INFO << npackets << " packets with " << nevents << " events, processing time per packet min/mean/max "
+             << mintime << "/" << sumtime/npackets << "/" << maxtime << " s" << SLogger::endmsg;
+  }
+  for(std::map<std::string, WorkerPackets>::const_iterator it=workers.begin(); it!=workers.end(); ++it){
+    m_logger << INFO << "worker " << it->first << ": " << it->second.npackets << " packets, "
+             << it->second.nevents << " events in " << it->second.proctime << " s, idle for "
+             << last - it->second.finished << " s at the end" << SLogger::endmsg;
+  }
+
+  // not part of the output of the cycle
+  gProof->GetOutputList()->Remove(trace);
+  delete trace;
+}
@@ -25,6 +25,7 @@ using namespace std;
 #include "include/ConstituentsHists.h"
 #include "include/MetaTreeFiller.h"
 #include "include/CleanerFiller.h"
+#include "include/EventContext.h"
 
 ClassImp( QCDCycle );
 
@@ -56,6 +57,19 @@ QCDCycle::QCDCycle()
   DeclareProperty( "BTaggingScaleFactors", m_dobsf );
 
 
+  m_arena = new EventArena();
+  m_treewriter = new TreeWriter();
+
+  // output settings of the CutTree: compression "ALGORITHM:LEVEL" with ZLIB, LZMA or LZ4,
+  // mantissa bits of the float columns ("column:bits", "*:bits" for all others)
+  // and packing of the boolean columns into one bit field
+  m_output_compression = "";
+  m_output_precision = "";
+  m_output_packflags = false;
+  DeclareProperty( "OutputCompression", m_output_compression );
+  DeclareProperty( "OutputPrecision", m_output_precision );
+  DeclareProperty( "OutputPackFlags", m_output_packflags );
+  m_output_policy = new OutputPolicy("OutputPolicy");
 }
 
 QCDCycle::~QCDCycle()
@@ -64,6 +78,9 @@ QCDCycle::~QCDCycle()
   if (m_jes_unc) delete m_jes_unc;
   
 
+  delete m_arena;
+  delete m_treewriter;
+  delete m_output_policy;
 }
 
 void QCDCycle::BeginCycle() throw( SError ) 
@@ -113,6 +130,15 @@ void QCDCycle::BeginInputData( const SInputData& id ) throw( SError )
 
  
   m_tree = GetOutputMetadataTree("CutTree");
+  // the tree fillers register their columns, one row is written per event
+  if(!m_output_policy->SetCompression(m_output_compression))
+    throw SError( ("invalid OutputCompression " + m_output_compression).c_str(), SError::StopExecution );
+  if(!m_output_policy->SetPrecision(m_output_precision))
+    throw SError( ("invalid OutputPrecision " + m_output_precision).c_str(), SError::StopExecution );
+  m_output_policy->SetPackFlags(m_output_packflags);
+  m_output_policy->Apply(m_tree);
+  m_treewriter->SetTree(m_tree);
+  m_treewriter->SetPolicy(m_output_policy);
 
   // event filter for HCAL laser events
   Selection* HCALlaser = new Selection("HCAL_laser_events");
@@ -143,7 +169,7 @@ void QCDCycle::BeginInputData( const SInputData& id ) throw( SError )
   IsoConeSel->addSelectionModule(new IsoConeSelection());
 
 
-  static Selection* mttbar_gen_selection = new Selection("Mttbar_Gen_Selection");
+  Selection* mttbar_gen_selection = new Selection("Mttbar_Gen_Selection");
   
   if ((id.GetVersion() == "TTbar")&& m_mttgencut){
     m_logger << INFO << "Applying mttbar generator cut from 700 to inf GeV." << SLogger::endmsg;
@@ -353,8 +379,8 @@ void QCDCycle::BeginInputData( const SInputData& id ) throw( SError )
   RegisterHistCollection( new ConstituentsHists("Constituents_after2D"    , m_tagchi2discr) );
   RegisterHistCollection( new ConstituentsHists("Constituents_afterCuts"  ,m_chi2discr) );
 
-  RegisterHistCollection( new MetaTreeFiller("MetaTree",m_tagchi2discr, m_tree) );
-  RegisterHistCollection( new CleanerFiller("Cleaner",m_chi2discr, m_tree) );
+  RegisterHistCollection( new MetaTreeFiller("MetaTree",m_tagchi2discr, m_treewriter) );
+  RegisterHistCollection( new CleanerFiller("Cleaner",m_chi2discr, m_treewriter) );
 
   //RegisterHistCollection( new TopTagDelRHists("TopTagDelRHists", m_chi2discr));
 
@@ -389,14 +415,36 @@ void QCDCycle::BeginInputData( const SInputData& id ) throw( SError )
   }
   
   
+  // selections used in ExecuteEvent
+  m_BSel = GetSelection("BSelection");
+  m_MuonSel = GetSelection("MuonSelection");
+  m_NoBSel = GetSelection("NoBSelection");
+  m_TopTagSel = GetSelection("TopTagSelection");
+  m_TwoDMuon = GetSelection("TwoDSelection");
+  m_HCALlaser = GetSelection("HCAL_laser_events");
+  m_ChiSelection = GetSelection("Chi2Selection");
+  m_ChiNoTag = GetSelection("Chi2NoTagSelection");
+  m_IsoSel = GetSelection("IsoConeSelection");
+  m_PTSel = GetSelection("PTSelection");
+  m_METSel = GetSelection("METSelelection");
+  m_HTmuonSel = GetSelection("HTmuonSelelection");
+  m_NJetSel = GetSelection("NJetSelection");
+  m_RazorSelection = GetSelection("RazorSelection");
+
   return;
 
 }
 
 void QCDCycle::EndInputData( const SInputData& id ) throw( SError ) 
 {
+  // write the tree row of the last event
+  m_treewriter->Commit();
+
   AnalysisCycle::EndInputData( id );
 
+  // release the transient objects and the cached views of the last event
+  m_arena->Reset();
+  EventContext::Instance()->Clear();
 
   return;
 
@@ -419,32 +467,16 @@ void QCDCycle::ExecuteEvent( const SInputData& id, Double_t weight) throw( SErro
   // this is the most important part: here the full analysis happens
   // user should implement selections, filling of histograms and results
 
+  // write the tree row filled by the previous event
+  m_treewriter->Commit();
+
   // first step: call Execute event of base class to perform basic consistency checks
   // also, the good-run selection is performed there and the calculator is reset
   AnalysisCycle::ExecuteEvent( id, weight );
 
-  // get the selections
-  
-
   //static Selection* TwoDMuonSel = GetSelection("TwoDSelection");
-  static Selection* BSel = GetSelection("BSelection");
-  static Selection* MuonSel = GetSelection("MuonSelection");
-  static Selection* NoBSel = GetSelection("NoBSelection");
   //static Selection* TopSel = GetSelection("TopSelection");
   //static Selection* TTreco = GetSelection("TTreco");
-  static Selection* TopTagSel = GetSelection("TopTagSelection");
-  static Selection* TwoDMuon = GetSelection("TwoDSelection");
-  static Selection* HCALlaser = GetSelection("HCAL_laser_events");
-  static Selection* ChiSelection = GetSelection("Chi2Selection");
-  static Selection* ChiNoTag = GetSelection("Chi2NoTagSelection");
-
-  static Selection* IsoSel = GetSelection("IsoConeSelection");
-
-  static Selection* PTSel = GetSelection("PTSelection");
-  static Selection* METSel = GetSelection("METSelelection");
-  static Selection* HTmuonSel = GetSelection("HTmuonSelelection");
-
-  static Selection* NJetSel = GetSelection("NJetSelection");
 
   EventCalc* calc = EventCalc::Instance();
   BaseCycleContainer* bcc = calc->GetBaseCycleContainer();
@@ -462,7 +494,7 @@ void QCDCycle::ExecuteEvent( const SInputData& id, Double_t weight) throw( SErro
 
 
 
-  if(!MuonSel->passSelection()) ClearEvent();
+  if(!m_MuonSel->passSelection()) ClearEvent();
   //static Selection* mttbar_gen_selection = GetSelection("Mttbar_Gen_Selection");
   //if(mttbar_gen_selection->passSelection()) ClearEvent();
 
@@ -471,12 +503,13 @@ void QCDCycle::ExecuteEvent( const SInputData& id, Double_t weight) throw( SErro
   /*	
   // reject laser events only for data
   if (calc->IsRealData()){
-    if (!HCALlaser->passSelection()) throw SError( SError::SkipEvent );
+    if (!m_HCALlaser->passSelection()) throw SError( SError::SkipEvent );
   }
   */
 
   
-  m_cleaner = new Cleaner();
+  m_arena->Reset();
+  m_cleaner = m_arena->NewCleaner();
   m_cleaner->SetJECUncertainty(m_jes_unc);
 
 
@@ -506,7 +539,7 @@ void QCDCycle::ExecuteEvent( const SInputData& id, Double_t weight) throw( SErro
   //bool topfit_flag = false;
    
 
-  if(TopTagSel->passSelection()){
+  if(m_TopTagSel->passSelection()){
     topfit->CalculateTopTag();
   } else{
     topfit->FillHighMassTTbarHypotheses();
@@ -519,7 +552,6 @@ void QCDCycle::ExecuteEvent( const SInputData& id, Double_t weight) throw( SErro
   m_tagchi2discr->FillDiscriminatorValues();
    
   
-  static Selection* RazorSelection = GetSelection("RazorSelection");
   BaseHists* Control_one   = GetHistCollection("Control_one");
   BaseHists* Control_two   = GetHistCollection("Control_two");
   BaseHists* Control_third = GetHistCollection("Control_third");
@@ -554,12 +586,12 @@ void QCDCycle::ExecuteEvent( const SInputData& id, Double_t weight) throw( SErro
   double test = sqrt(pow(0.5*(toplep.M2()+tophad.M2() - exp_tophad_mass*exp_tophad_mass - exp_toplep_mass*exp_toplep_mass),2))/1000;
   
 
-  if(TopTagSel->passSelection()){
+  if(m_TopTagSel->passSelection()){
     //if(test < 40 && pTrel(muon,blep_discr)< 15) ClearEvent();
     if((pTrel(muon,blep_discr)<20 && deltaRmin(&muon,antikjets_before)<0.2) || deltaRmin(&muon,antikjets_before)<0.1) ClearEvent();
   }
   else{
-    if(!TwoDMuon->passSelection()) ClearEvent();
+    if(!m_TwoDMuon->passSelection()) ClearEvent();
   }
   */
   
@@ -588,7 +620,7 @@ void QCDCycle::ExecuteEvent( const SInputData& id, Double_t weight) throw( SErro
  
   if(y<0.02) y=0.02;
 
-  if(!IsoSel->passSelection()) ClearEvent();
+  if(!m_IsoSel->passSelection()) ClearEvent();
 
 
 
@@ -602,15 +634,17 @@ void QCDCycle::ExecuteEvent( const SInputData& id, Double_t weight) throw( SErro
 
 
 
-  //if(!TwoDMuon->passSelection()) ClearEvent();
+  //if(!m_TwoDMuon->passSelection()) ClearEvent();
 
   //Constituents_after2D->Fill();
 
-  //if(!RazorSelection->passSelection()) ClearEvent();
+  //if(!m_RazorSelection->passSelection()) ClearEvent();
 
   
   
   if(bcc->jets) m_cleaner->JetCleaner(50,2.5,true);
+  // the jets changed in place, the sorted views of the histograms are rebuilt
+  EventContext::Instance()->Invalidate();
  
 
 
@@ -623,13 +657,13 @@ void QCDCycle::ExecuteEvent( const SInputData& id, Double_t weight) throw( SErro
   //RazorHists->Fill();
   //FillControlHistos("_PTSel");
   //Control_one->Fill();
-  if(!PTSel->passSelection()) ClearEvent();
+  if(!m_PTSel->passSelection()) ClearEvent();
   //FillControlHistos("_METSel");
   //Control_two->Fill();
-  if(!METSel->passSelection()) ClearEvent();
+  if(!m_METSel->passSelection()) ClearEvent();
   //FillControlHistos("_HTmuonSel");
   //Control_third->Fill();
-  if(!HTmuonSel->passSelection()) ClearEvent();
+  if(!m_HTmuonSel->passSelection()) ClearEvent();
   
 
   
@@ -640,7 +674,7 @@ void QCDCycle::ExecuteEvent( const SInputData& id, Double_t weight) throw( SErro
   //if(m_bsf && m_addGenInfo) {
   //  calc->ProduceWeight(m_bsf->GetWeight());
   //}
-  if(!NJetSel->passSelection()) ClearEvent();
+  if(!m_NJetSel->passSelection()) ClearEvent();
   
 
   bcc->recoHyps->clear();    
@@ -650,7 +684,7 @@ void QCDCycle::ExecuteEvent( const SInputData& id, Double_t weight) throw( SErro
 
   //bool topfit_flag = false;
   
-  if(TopTagSel->passSelection()){
+  if(m_TopTagSel->passSelection()){
    
     //topfit->FillHighMassTTbarHypotheses();
     topfit->CalculateTopTag();
@@ -697,8 +731,8 @@ void QCDCycle::ExecuteEvent( const SInputData& id, Double_t weight) throw( SErro
   BaseHists* Tag_Muon_bjet = GetHistCollection("Tag_muon_bjet");
   BaseHists* NoTag_Muon_bjet = GetHistCollection("NoTag_muon_bjet");
 
-  BaseHists* BSelH = GetHistCollection("BSel");
-  BaseHists* NoBSelH = GetHistCollection("NoBSel");
+  BaseHists* BSelH = GetHistCollection("m_BSel");
+  BaseHists* NoBSelH = GetHistCollection("m_NoBSel");
 
   BaseHists* TagBSelH = GetHistCollection("TagBSel");
   BaseHists* TagNoBSelH = GetHistCollection("TagNoBSel");
@@ -735,26 +769,26 @@ void QCDCycle::ExecuteEvent( const SInputData& id, Double_t weight) throw( SErro
   //Neutrinos->Fill();
   //Event_MJetsHists->Fill();
 
-  //if(!ChiSelection->passSelection()) ClearEvent();
+  //if(!m_ChiSelection->passSelection()) ClearEvent();
 
-  if(BSel->passSelection() && ChiSelection->passSelection()) BSelH->Fill();
-  if(BSel->passSelection() && ChiSelection->passSelection()) FillControlHistos("_BTag");
-  if(BSel->passSelection() && ChiSelection->passSelection()) Chi2_HistsBTag->Fill();
-  if(BSel->passSelection() && ChiSelection->passSelection()) NeutrinosBSel->Fill();
-  if(NoBSel->passSelection() && ChiNoTag->passSelection() ) NoBSelH->Fill();
-  if(NoBSel->passSelection() && ChiNoTag->passSelection() ) FillControlHistos("_NoBTag");
-  if(NoBSel->passSelection() && ChiNoTag->passSelection() ) NeutrinosNoBSel->Fill();
+  if(m_BSel->passSelection() && m_ChiSelection->passSelection()) BSelH->Fill();
+  if(m_BSel->passSelection() && m_ChiSelection->passSelection()) FillControlHistos("_BTag");
+  if(m_BSel->passSelection() && m_ChiSelection->passSelection()) Chi2_HistsBTag->Fill();
+  if(m_BSel->passSelection() && m_ChiSelection->passSelection()) NeutrinosBSel->Fill();
+  if(m_NoBSel->passSelection() && m_ChiNoTag->passSelection() ) NoBSelH->Fill();
+  if(m_NoBSel->passSelection() && m_ChiNoTag->passSelection() ) FillControlHistos("_NoBTag");
+  if(m_NoBSel->passSelection() && m_ChiNoTag->passSelection() ) NeutrinosNoBSel->Fill();
   //if(topfit_flag)TopTagDeltaRHists->Fill();
 
 
-  if(!TopTagSel->passSelection() && ChiNoTag->passSelection()){
+  if(!m_TopTagSel->passSelection() && m_ChiNoTag->passSelection()){
     NoTag_Muon_bjet->Fill();
     FillControlHistos("_NoTopTag");
-    if(BSel->passSelection()) {
+    if(m_BSel->passSelection()) {
       NoTagBSelH->Fill();
       Event_NoTagBSel->Fill();
     }
-    if(NoBSel->passSelection()){ 
+    if(m_NoBSel->passSelection()){ 
       NoTagNoBSelH->Fill();
       Event_NoTagNoBSel->Fill();
     }
@@ -762,7 +796,7 @@ void QCDCycle::ExecuteEvent( const SInputData& id, Double_t weight) throw( SErro
 
   }
   
-  if(!TopTagSel->passSelection() || !ChiSelection->passSelection()) ClearEvent();
+  if(!m_TopTagSel->passSelection() || !m_ChiSelection->passSelection()) ClearEvent();
 
   FillControlHistos("_TopTag");
   NeutrinosTopTag->Fill();
@@ -770,11 +804,11 @@ void QCDCycle::ExecuteEvent( const SInputData& id, Double_t weight) throw( SErro
   //AfterTagDeltaRHists->Fill();
   Tag_Muon_bjet->Fill();
   
-  if(BSel->passSelection()) {
+  if(m_BSel->passSelection()) {
     TagBSelH->Fill();
     Event_TagBSel->Fill();
   }
-  if(NoBSel->passSelection()){
+  if(m_NoBSel->passSelection()){
     TagNoBSelH->Fill();
     Event_TagNoBSel->Fill();
   }
@@ -0,0 +1,192 @@
+#include "include/SkimBranchFilter.h"
+#include "include/EventListWriter.h"
+
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+// ROOT include(s):
+#include <TObjArray.h>
+#include <TSystem.h>
+
+using namespace std;
+
+namespace {
+  /// suffix of the part files of the used branches
+  const char* s_used_suffix = ".txt";
+
+  /// name of a sub-branch including the name of its top-level branch
+  std::string FullName(TBranch* branch, const std::string& top){
+    std::string name = branch->GetName();
+    if(name.compare(0, top.size()+1, top+".")==0) return name;
+    return top + "." + name;
+  }
+}
+
+SkimBranchFilter::SkimBranchFilter(const char* name)
+  : m_logger(name)
+{
+}
+
+SkimBranchFilter::~SkimBranchFilter()
+{
+}
+
+void SkimBranchFilter::AddKeep(const std::string& names)
+{
+  std::istringstream stream(names);
+  std::string name;
+  while(stream >> name) m_keep.insert(name);
+}
+
+bool SkimBranchFilter::ReadKeepFile(const std::string& filename)
+{
+  std::ifstream file(filename.c_str());
+  if(!file.is_open()){
+    m_logger << ERROR << "cannot open branch list " << filename << SLogger::endmsg;
+    return false;
+  }
+  std::string line;
+  while(std::getline(file, line)){
+    AddKeep(line.substr(0, line.find('#')));
+  }
+  return true;
+}
+
+bool SkimBranchFilter::KeepField(TBranch* branch, const std::string& top) const
+{
+  return m_keep.count(FullName(branch, top))>0;
+}
+
+void SkimBranchFilter::FilterFields(TBranch* branch, const std::string& top, int& ndisabled) const
+{
+  TObjArray* branches = branch->GetListOfBranches();
+  for(int i=0; i<branches->GetEntriesFast(); ++i){
+    TBranch* field = (TBranch*) branches->At(i);
+    if(KeepField(field, top)) continue;
+    if(field->GetListOfBranches()->GetEntriesFast()>0){
+      FilterFields(field, top, ndisabled);
+    } else {
+      field->SetBit(TBranch::kDoNotProcess);
+      ++ndisabled;
+    }
+  }
+}
+
+void SkimBranchFilter::Apply(TTree* tree)
+{
+  if(!tree || m_keep.empty()) return;
+
+  std::vector<TBranch*> removed;
+  int ndisabled = 0;
+
+  TObjArray* branches = tree->GetListOfBranches();
+  for(int i=0; i<branches->GetEntriesFast(); ++i){
+    TBranch* branch = (TBranch*) branches->At(i);
+    std::string name = branch->GetName();
+    if(m_keep.count(name)) continue;
+
+    // fields of the branch in the keep list
+    std::set<std::string>::const_iterator it = m_keep.lower_bound(name+".");
+    bool fields = it!=m_keep.end() && it->compare(0, name.size()+1, name+".")==0;
+    if(fields) FilterFields(branch, name, ndisabled);
+    else removed.push_back(branch);
+  }
+
+  for(unsigned int i=0; i<removed.size(); ++i){
+    branches->Remove(removed[i]);
+    delete removed[i];
+  }
+  branches->Compress();
+  tree->GetListOfLeaves()->Compress();
+
+  m_logger << INFO << "removed " << removed.size() << " branches and " << ndisabled
+           << " fields from " << tree->GetName() << ", " << branches->GetEntriesFast()
+           << " branches are written" << SLogger::endmsg;
+}
+
+void SkimBranchFilter::CollectUsed(TBranch* branch, std::set<std::string>& used)
+{
+  std::string top = branch->GetName();
+  TObjArray* fields = branch->GetListOfBranches();
+
+  std::vector<TBranch*> stack;
+  std::vector<std::string> read;
+  bool all = true;
+  for(int i=0; i<fields->GetEntriesFast(); ++i) stack.push_back((TBranch*) fields->At(i));
+  while(!stack.empty()){
+    TBranch* field = stack.back();
+    stack.pop_back();
+    TObjArray* sub = field->GetListOfBranches();
+    if(sub->GetEntriesFast()>0){
+      for(int i=0; i<sub->GetEntriesFast(); ++i) stack.push_back((TBranch*) sub->At(i));
+    } else if(field->GetReadEntry()>=0){
+      read.push_back(FullName(field, top));
+    } else {
+      all = false;
+    }
+  }
+
+  if(all){
+    if(branch->GetReadEntry()>=0 || !read.empty()) used.insert(top);
+  } else {
+    used.insert(read.begin(), read.end());
+  }
+}
+
+void SkimBranchFilter::AddUsedBranches(TTree* tree, std::set<std::string>& used)
+{
+  if(!tree) return;
+
+  TObjArray* branches = tree->GetListOfBranches();
+  for(int i=0; i<branches->GetEntriesFast(); ++i){
+    TBranch* branch = (TBranch*) branches->At(i);
+    // all of the branch is known to be read
+    if(used.count(branch->GetName())) continue;
+    CollectUsed(branch, used);
+  }
+}
+
+bool SkimBranchFilter::WriteBranchList(const std::set<std::string>& names, const std::string& filename)
+{
+  std::ofstream file(filename.c_str());
+  if(!file.is_open()) return false;
+  file << "# input branches read by the cycle" << std::endl;
+  for(std::set<std::string>::const_iterator it=names.begin(); it!=names.end(); ++it){
+    file << *it << std::endl;
+  }
+  file.close();
+  return !file.fail();
+}
+
+bool SkimBranchFilter::WriteUsedBranchesPart(const std::set<std::string>& used, const std::string& filename)
+{
+  return WriteBranchList(used, EventListWriter::PartFile(filename, s_used_suffix));
+}
+
+bool SkimBranchFilter::MergeUsedBranches(const std::string& filename)
+{
+  std::vector<std::string> parts = EventListWriter::PartFiles(filename, s_used_suffix);
+
+  // a branch listed by one process and fields of it listed by another: the whole branch
+  SkimBranchFilter merged("SkimBranchFilter");
+  for(unsigned int i=0; i<parts.size(); ++i){
+    if(!merged.ReadKeepFile(parts[i])) return false;
+  }
+  std::set<std::string> names;
+  for(std::set<std::string>::const_iterator it=merged.m_keep.begin(); it!=merged.m_keep.end(); ++it){
+    std::string::size_type dot = it->find('.');
+    if(dot!=std::string::npos && merged.m_keep.count(it->substr(0, dot))) continue;
+    names.insert(*it);
+  }
+
+  if(!WriteBranchList(names, filename)) return false;
+  RemoveUsedBranchesParts(filename);
+  return true;
+}
+
+void SkimBranchFilter::RemoveUsedBranchesParts(const std::string& filename)
+{
+  std::vector<std::string> parts = EventListWriter::PartFiles(filename, s_used_suffix);
+  for(unsigned int i=0; i<parts.size(); ++i) gSystem->Unlink(parts[i].c_str());
+}
@@ -0,0 +1,81 @@
+#include "include/SortedViewCache.h"
+#include "include/EventContext.h"
+#include "include/EventCalc.h"
+#include "include/Utils.h"
+
+namespace {
+
+  class HigherMass{
+  public:
+    bool operator() (const Particle& p1, const Particle& p2) const {
+      return p1.v4().M2() > p2.v4().M2();
+    }
+  };
+
+}
+
+SortedViewCache* SortedViewCache::Instance()
+{
+  return &EventContext::Instance()->Views();
+}
+
+void SortedViewCache::Invalidate()
+{
+  // the entries are kept, references to their views stay valid
+  for(unsigned int i=0; i<m_jets.size(); ++i) m_jets[i].valid = false;
+  for(unsigned int i=0; i<m_topjets.size(); ++i) m_topjets[i].valid = false;
+}
+
+void SortedViewCache::Clear()
+{
+  m_jets.clear();
+  m_topjets.clear();
+}
+
+const IndexView<Jet>& SortedViewCache::Get(const std::vector<Jet>* jets, E_Ordering ordering)
+{
+  return Lookup(m_jets, jets, ordering);
+}
+
+const IndexView<TopJet>& SortedViewCache::Get(const std::vector<TopJet>* topjets, E_Ordering ordering)
+{
+  return Lookup(m_topjets, topjets, ordering);
+}
+
+template<typename T>
+const IndexView<T>& SortedViewCache::Lookup(std::deque<Entry<T> >& entries, const std::vector<T>* collection, E_Ordering ordering)
+{
+  BaseCycleContainer* bcc = EventCalc::Instance()->GetBaseCycleContainer();
+
+  unsigned int size = collection ? collection->size() : 0;
+  const T* data = size ? &collection->at(0) : 0;
+
+  Entry<T>* entry = 0;
+  for(unsigned int i=0; i<entries.size(); ++i){
+    if(entries[i].collection==collection && entries[i].ordering==ordering){
+      entry = &entries[i];
+      break;
+    }
+  }
+
+  if(entry && entry->valid && entry->run==bcc->run && entry->event==bcc->event
+     && entry->size==size && entry->data==data) return entry->view;
+
+  if(!entry){
+    entries.push_back(Entry<T>());
+    entry = &entries.back();
+    entry->collection = collection;
+    entry->ordering = ordering;
+  }
+  entry->run = bcc->run;
+  entry->event = bcc->event;
+  entry->size = size;
+  entry->data = data;
+  entry->valid = true;
+
+  entry->view.Reset(collection);
+  if(ordering==e_HigherMass) entry->view.Sort(HigherMass());
+  else entry->view.Sort(HigherPt());
+
+  return entry->view;
+}
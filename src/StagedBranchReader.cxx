@@ -0,0 +1,130 @@
+#include "include/StagedBranchReader.h"
+
+#include <sstream>
+
+// ROOT include(s):
+#include <TBranchElement.h>
+#include <TObjArray.h>
+
+// SFrame include(s):
+#include "include/EventCalc.h"
+
+using namespace std;
+
+StagedBranchReader::StagedBranchReader(const char* name)
+  : m_tree(0), m_reference(0), m_loaded_entry(-1), m_nloaded(0), m_bytes(0), m_logger(name)
+{
+}
+
+StagedBranchReader::~StagedBranchReader()
+{
+}
+
+void StagedBranchReader::AddEarly(const void* address)
+{
+  m_early_addresses.insert(address);
+}
+
+void StagedBranchReader::AddEarlyBranch(const std::string& name)
+{
+  if(!name.empty()) m_early_names.insert(name);
+}
+
+void StagedBranchReader::AddEarlyBranches(const std::string& names)
+{
+  std::istringstream stream(names);
+  std::string name;
+  while(stream >> name) AddEarlyBranch(name);
+}
+
+void StagedBranchReader::SetProcess(TBranch* branch, bool process)
+{
+  if(process) branch->ResetBit(TBranch::kDoNotProcess);
+  else branch->SetBit(TBranch::kDoNotProcess);
+
+  TObjArray* branches = branch->GetListOfBranches();
+  for(int i=0; i<branches->GetEntriesFast(); ++i){
+    SetProcess((TBranch*) branches->At(i), process);
+  }
+}
+
+void StagedBranchReader::Setup(TTree* tree)
+{
+  m_tree = tree;
+  m_reference = 0;
+  m_deferred.clear();
+  m_loaded_entry = -1;
+
+  if(!tree) return;
+
+  // always needed by AnalysisCycle::ExecuteEvent: trigger names and the pile-up information
+  BaseCycleContainer* bcc = EventCalc::Instance()->GetBaseCycleContainer();
+  std::set<const void*> always;
+  always.insert(&bcc->triggerNames);
+  always.insert(&bcc->triggerResults);
+  always.insert(&bcc->genInfo);
+
+  std::set<const void*> found;
+  std::vector<TBranch*> candidates;
+
+  TObjArray* branches = tree->GetListOfBranches();
+  for(int i=0; i<branches->GetEntriesFast(); ++i){
+    TBranch* branch = (TBranch*) branches->At(i);
+    const void* address = branch->GetAddress();
+    if(!address) continue;
+
+    bool early = !branch->InheritsFrom(TBranchElement::Class())
+      || always.count(address)
+      || m_early_addresses.count(address)
+      || m_early_names.count(branch->GetName());
+
+    if(m_early_addresses.count(address)) found.insert(address);
+
+    if(early){
+      if(!m_reference) m_reference = branch;
+      SetProcess(branch, true);
+    } else {
+      candidates.push_back(branch);
+    }
+  }
+
+  if(found.size()!=m_early_addresses.size() || !m_reference){
+    m_logger << WARNING << "not all early collections are connected to a branch of "
+             << tree->GetName() << ", reading all branches for every event" << SLogger::endmsg;
+    for(unsigned int i=0; i<candidates.size(); ++i) SetProcess(candidates[i], true);
+    return;
+  }
+
+  m_deferred = candidates;
+  for(unsigned int i=0; i<m_deferred.size(); ++i) SetProcess(m_deferred[i], false);
+
+  m_logger << DEBUG << "reading " << m_deferred.size() << " branches of "
+           << tree->GetName() << " for selected events only" << SLogger::endmsg;
+}
+
+void StagedBranchReader::LoadDeferred()
+{
+  if(m_deferred.empty()) return;
+
+  // the framework reads the branches directly, the entry is only known to them
+  Long64_t entry = m_reference->GetReadEntry();
+  if(entry<0 || entry==m_loaded_entry) return;
+
+  for(unsigned int i=0; i<m_deferred.size(); ++i){
+    int nbytes = m_deferred[i]->GetEntry(entry, 1);
+    if(nbytes<0){
+      m_logger << ERROR << "failed to read branch " << m_deferred[i]->GetName()
+               << " for entry " << entry << SLogger::endmsg;
+      throw SError( SError::SkipEvent );
+    }
+    m_bytes += nbytes;
+  }
+  m_loaded_entry = entry;
+  ++m_nloaded;
+}
+
+void StagedBranchReader::PrintStatistics()
+{
+  m_logger << INFO << "deferred branches read for " << m_nloaded << " events ("
+           << m_bytes/1024./1024. << " MB)" << SLogger::endmsg;
+}
@@ -1,6 +1,7 @@
 #include "include/TopEffiHists.h"
 #include "include/SelectionModules.h"
 #include "include/EventCalc.h"
+#include "include/JetSoA.h"
 #include "TH2.h"
 
 #include <iostream>
@@ -59,9 +60,12 @@ void TopEffiHists::Fill()
 
 
   
+  // top jet kinematics as contiguous arrays for the matching with the generator particles
+  const JetSoA& topjets_soa = JetSoA::TopJets(bcc->topjets);
+
   for (unsigned int i =0; i<bcc->topjets->size(); ++i)
     {
-      TopJet topjet =  bcc->topjets->at(i);
+      TopJet& topjet =  bcc->topjets->at(i);
 
       double mmin=0;
       double mjet=0;
@@ -87,23 +91,23 @@ void TopEffiHists::Fill()
    
       for(unsigned int j=0; j<bcc->genparticles->size(); ++j)
 	{
-	  GenParticle genp = bcc->genparticles->at(j);
+	  const GenParticle& genp = bcc->genparticles->at(j);
 
 	  if (genp.pdgId() == 24 || genp.pdgId() == -24 )
 	    Hist("Mjet_W")->Fill(mjet,weight);
 
-	  Hist("r")->Fill(topjet.deltaR(genp),weight);
+	  double r = topjets_soa.DeltaR(i,genp);
+	  Hist("r")->Fill(r,weight);
 
 	  if (genp.pdgId() == 6 || genp.pdgId() == -6 )
 	    {
-	      double r = topjet.deltaR(genp);
 	      if (r < 0.8)
 		{
 		 
 		  Hist("top_pT")->Fill(genp.pt(),weight);
 		  Hist("top_Eta")->Fill(genp.eta(), weight);
 		  Hist("top_Phi")->Fill(genp.phi(), weight);
-		  Hist("r_topjet")->Fill(topjet.deltaR(genp),weight);
+		  Hist("r_topjet")->Fill(r,weight);
 		  Hist("mTopjet")->Fill(mjet,weight);
 
 
@@ -21,11 +21,17 @@ TopTagTMVACycle::TopTagTMVACycle()
   // set the integrated luminosity per bin for the lumi-yield control plots
   SetIntLumiPerBin(250.);
 
+  // compression of the TopTagTree: "ALGORITHM:LEVEL" with ZLIB, LZMA or LZ4
+  m_output_compression = "";
+  DeclareProperty( "OutputCompression", m_output_compression );
+  m_output_policy = new OutputPolicy("OutputPolicy");
+
 }
 
 TopTagTMVACycle::~TopTagTMVACycle() 
 {
   // destructor
+  delete m_output_policy;
 }
 
 void TopTagTMVACycle::BeginCycle() throw( SError ) 
@@ -66,11 +72,17 @@ void TopTagTMVACycle::BeginInputData( const SInputData& id ) throw( SError )
   
   // this class fills the tree for the TMVA analysis
   TTree * toptagtree = GetOutputMetadataTree("TopTagTree");
+  if(!m_output_policy->SetCompression(m_output_compression))
+    throw SError( ("invalid OutputCompression " + m_output_compression).c_str(), SError::StopExecution );
+  m_output_policy->Apply(toptagtree);
   RegisterHistCollection( new TMVATreeFiller("TopTagFiller", toptagtree) );
 
   // important: initialise histogram collections after their definition
   InitHistos();
 
+  // selections used in ExecuteEvent
+  m_CAJetSel = GetSelection("CAJetSelection");
+
   return;
 
 }
@@ -104,11 +116,10 @@ void TopTagTMVACycle::ExecuteEvent( const SInputData& id, Double_t weight) throw
   // also, the good-run selection is performed there and the calculator is reset
   AnalysisCycle::ExecuteEvent( id, weight );
 
-  static Selection* CAJetSel = GetSelection("CAJetSelection");
 
   BaseHists* TreeFiller = GetHistCollection("TopTagFiller");
 
-  if(!CAJetSel->passSelection())  throw SError( SError::SkipEvent );
+  if(!m_CAJetSel->passSelection())  throw SError( SError::SkipEvent );
 
   TreeFiller->Fill();
 
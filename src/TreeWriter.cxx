@@ -0,0 +1,86 @@
+#include "include/TreeWriter.h"
+#include "include/OutputPolicy.h"
+
+#include <sstream>
+
+TreeWriter::TreeWriter()
+  : m_tree(0), m_policy(0), m_flags(0), m_touched(false), m_rows(0)
+{
+}
+
+TreeWriter::~TreeWriter()
+{
+}
+
+void TreeWriter::SetTree(TTree* tree)
+{
+  m_tree = tree;
+  m_floats.clear();
+  m_ints.clear();
+  m_bools.clear();
+  m_float_bits.clear();
+  m_flag_columns.clear();
+  m_flags = 0;
+  m_touched = false;
+  m_rows = 0;
+}
+
+Float_t* TreeWriter::AddFloat(const char* name)
+{
+  m_floats.push_back(0.);
+  m_float_bits.push_back(m_policy ? m_policy->PrecisionBits(name) : -1);
+  Float_t* address = &m_floats.back();
+  if(m_tree) m_tree->Branch(name, address, (std::string(name)+"/F").c_str());
+  return address;
+}
+
+Int_t* TreeWriter::AddInt(const char* name)
+{
+  m_ints.push_back(0);
+  Int_t* address = &m_ints.back();
+  if(m_tree) m_tree->Branch(name, address, (std::string(name)+"/I").c_str());
+  return address;
+}
+
+Bool_t* TreeWriter::AddBool(const char* name)
+{
+  m_bools.push_back(false);
+  Bool_t* address = &m_bools.back();
+  if(!m_tree) return address;
+
+  if(m_policy && m_policy->PackFlags() && m_flag_columns.size()<32){
+    if(m_flag_columns.empty()) m_tree->Branch("flags", &m_flags, "flags/i");
+    std::ostringstream alias;
+    alias << "((flags>>" << m_flag_columns.size() << ")&1)";
+    m_tree->SetAlias(name, alias.str().c_str());
+    m_flag_columns.push_back(m_bools.size()-1);
+  } else {
+    m_tree->Branch(name, address, (std::string(name)+"/O").c_str());
+  }
+  return address;
+}
+
+void TreeWriter::Commit()
+{
+  if(!m_touched) return;
+  for(unsigned int i=0; i<m_floats.size(); ++i){
+    if(m_float_bits[i]>=0) m_floats[i] = OutputPolicy::Truncate(m_floats[i], m_float_bits[i]);
+  }
+  m_flags = 0;
+  for(unsigned int i=0; i<m_flag_columns.size(); ++i){
+    if(m_bools[m_flag_columns[i]]) m_flags |= 1u << i;
+  }
+  if(m_tree){
+    m_tree->Fill();
+    ++m_rows;
+  }
+  Reset();
+}
+
+void TreeWriter::Reset()
+{
+  for(unsigned int i=0; i<m_floats.size(); ++i) m_floats[i] = 0.;
+  for(unsigned int i=0; i<m_ints.size(); ++i) m_ints[i] = 0;
+  for(unsigned int i=0; i<m_bools.size(); ++i) m_bools[i] = false;
+  m_touched = false;
+}
@@ -19,6 +19,8 @@ using namespace std;
 #include "include/NeutrinoHists.h"
 #include "include/TopFitCalc.h"
 #include "include/DelRHists.h"
+#include "include/HistogramOnlyMode.h"
+#include "include/EventContext.h"
 
 
 
@@ -34,6 +36,10 @@ ZPrimeTopTaggerCycle::ZPrimeTopTaggerCycle()
   SetIntLumiPerBin(250.);
   m_mttgencut = false;
   DeclareProperty( "ApplyMttbarGenCut", m_mttgencut );
+
+  // histograms only: no output tree may be configured for the InputData, nothing is written per event
+  m_histogram_only = false;
+  DeclareProperty( "HistogramOnly", m_histogram_only );
 }
 
 ZPrimeTopTaggerCycle::~ZPrimeTopTaggerCycle()
@@ -70,6 +76,8 @@ void ZPrimeTopTaggerCycle::BeginInputData( const SInputData& id ) throw( SError
 
    // declaration of histograms and selections
 
+  if(m_histogram_only) HistogramOnlyMode::Check( id );
+
   // Important: first call BeginInputData of base class
   AnalysisCycle::BeginInputData( id );
 
@@ -88,7 +96,7 @@ void ZPrimeTopTaggerCycle::BeginInputData( const SInputData& id ) throw( SError
   Selection * TwoDMuonSel = new Selection("TwoDSelection");
   TwoDMuonSel->addSelectionModule(new TwoDCutMuon(.5,25));
 
-  static Selection* mttbar_gen_selection = new Selection("Mttbar_Gen_Selection");
+  Selection* mttbar_gen_selection = new Selection("Mttbar_Gen_Selection");
   if (((id.GetVersion() == "TTbar_0to700") || (id.GetVersion() == "TTbar") )  ) {
     m_logger << INFO << "Applying mttbar generator cut from 0 to 700 GeV." << SLogger::endmsg;
     mttbar_gen_selection->addSelectionModule(new MttbarGenCut(0,700));
@@ -264,6 +272,15 @@ void ZPrimeTopTaggerCycle::BeginInputData( const SInputData& id ) throw( SError
 
 
 
+  // selections used in ExecuteEvent
+  m_BSel = GetSelection("BSelection");
+  m_MuonSel = GetSelection("MuonSelection");
+  m_NoBSel = GetSelection("NoBSelection");
+  m_TopSel = GetSelection("TopSelection");
+  m_TopTagSel = GetSelection("TopTagSelection");
+  m_TwoDMuon = GetSelection("TwoDSelection");
+  m_mttbar_gen_selection = GetSelection("Mttbar_Gen_Selection");
+
   return;
 
 }
@@ -272,6 +289,9 @@ void ZPrimeTopTaggerCycle::EndInputData( const SInputData& id ) throw( SError )
 {
   AnalysisCycle::EndInputData( id );
 
+  // release the views on the jets of the last event
+  EventContext::Instance()->Clear();
+
   /*
   m_bp_chi2->PrintStatistics();
   m_bp_sumdr->PrintStatistics();
@@ -309,13 +329,7 @@ void ZPrimeTopTaggerCycle::ExecuteEvent( const SInputData& id, Double_t weight)
   // get the selections
 
   //static Selection* TwoDMuonSel = GetSelection("TwoDSelection");
-  static Selection* BSel = GetSelection("BSelection");
-  static Selection* MuonSel = GetSelection("MuonSelection");
-  static Selection* NoBSel = GetSelection("NoBSelection");
-  static Selection* TopSel = GetSelection("TopSelection");
   //static Selection* TTreco = GetSelection("TTreco");
-  static Selection* TopTagSel = GetSelection("TopTagSelection");
-  static Selection* TwoDMuon = GetSelection("TwoDSelection");
   //static Selection* HCALlaser = GetSelection("HCAL_laser_events");
 
   EventCalc* calc = EventCalc::Instance();
@@ -332,13 +346,12 @@ void ZPrimeTopTaggerCycle::ExecuteEvent( const SInputData& id, Double_t weight)
   */
 
  
-  if(!MuonSel->passSelection())  throw SError( SError::SkipEvent );
-  static Selection* mttbar_gen_selection = GetSelection("Mttbar_Gen_Selection");
+  if(!m_MuonSel->passSelection())  throw SError( SError::SkipEvent );
 
   //if(calc->GetMuons()->at(0).relIso() > 0.4) throw SError( SError::SkipEvent );	
 
 
-  if(!mttbar_gen_selection->passSelection())  throw SError( SError::SkipEvent );
+  if(!m_mttbar_gen_selection->passSelection())  throw SError( SError::SkipEvent );
 
   //BaseHists* JetEffiHists = GetHistCollection("JetEffiHists");	
   //JetEffiHists->Fill();
@@ -348,11 +361,11 @@ void ZPrimeTopTaggerCycle::ExecuteEvent( const SInputData& id, Double_t weight)
   //do reconstruction here
   bcc->recoHyps->clear();    
 
-  if(!TopSel->passSelection())  throw SError( SError::SkipEvent );
+  if(!m_TopSel->passSelection())  throw SError( SError::SkipEvent );
 
 
 
-  //if(!TopTagSel->passSelection()) throw SError( SError::SkipEvent );
+  //if(!m_TopTagSel->passSelection()) throw SError( SError::SkipEvent );
   
   //topfit->FillTTbarTagHypotheses();
 
@@ -374,7 +387,7 @@ void ZPrimeTopTaggerCycle::ExecuteEvent( const SInputData& id, Double_t weight)
 
 
 
-  if(TopTagSel->passSelection()){
+  if(m_TopTagSel->passSelection()){
     topfit->CalculateTopTag();
   }
   else{
@@ -416,7 +429,7 @@ void ZPrimeTopTaggerCycle::ExecuteEvent( const SInputData& id, Double_t weight)
   BaseHists* HistsBTag = GetHistCollection("BTag");
   BaseHists* HistsNoBTag = GetHistCollection("NoBTag");
   
-  BaseHists* HistsTopSel = GetHistCollection("TopSel");
+  BaseHists* HistsTopSel = GetHistCollection("m_TopSel");
   
   BaseHists* Chi2_HistsNoCuts = GetHistCollection("Chi2_NoCuts");
   BaseHists* Chi2_HistsBTag = GetHistCollection("Chi2_BTag");
@@ -552,7 +565,7 @@ void ZPrimeTopTaggerCycle::ExecuteEvent( const SInputData& id, Double_t weight)
   }
  
   if(notoptag ==1)NoTagMJets->Fill();
-  if(TwoDMuon->passSelection() && notoptag ==1)NoTagMuonSel_old->Fill();
+  if(m_TwoDMuon->passSelection() && notoptag ==1)NoTagMuonSel_old->Fill();
 
   if(deltaRmin(&(bcc->muons->at(0)), bcc->jets)>0.5 && notoptag ==1)NoTagMJets_delR05->Fill();
 
@@ -565,31 +578,31 @@ void ZPrimeTopTaggerCycle::ExecuteEvent( const SInputData& id, Double_t weight)
   if( (pow(deltaRmin(&neutrino, bcc->jets)-.8,2)*6.25 + pow(pTrel(&neutrino, bcc->jets)-100,2)*0.0000694) > 1 && notoptag ==1 && (hyp->toplep_v4()+hyp->tophad_v4()).M()>500 )NoTagMJets_neutrino->Fill();
   if( (pow(deltaRmin(&neutrino, bcc->jets)-.8,2)*1.5625 + pow(pTrel(&muon, bcc->jets),2)*.00308641975) > 1 && notoptag ==1 && (hyp->toplep_v4()+hyp->tophad_v4()).M()>500){
     NoTagMJets_neutrino_muon->Fill();
-    if(BSel->passSelection())
+    if(m_BSel->passSelection())
       NoTagMJetsBTag_neutrino_muon->Fill();
     else
       NoTagMJetsNoBTag_neutrino_muon->Fill();
   }
  
   /*
-  if(BSel->passSelection()){
+  if(m_BSel->passSelection()){
     HistsBTag->Fill();
     MJetsBTag->Fill();
     //Chi2_HistsBTag->Fill();
   }
-  if(NoBSel->passSelection()){
+  if(m_NoBSel->passSelection()){
     HistsNoBTag->Fill(); 
     MJetsNoBTag->Fill(); 
     // Chi2_HistsNoBTag->Fill();
   }
   */
-  //if(!TopTagSel->passSelection())  throw SError( SError::SkipEvent );
+  //if(!m_TopTagSel->passSelection())  throw SError( SError::SkipEvent );
   
-  //  if(TopTagSel->passSelection()) 
+  //  if(m_TopTagSel->passSelection()) 
 
 
  
-  if(!TopTagSel->passSelection()) throw SError( SError::SkipEvent );
+  if(!m_TopTagSel->passSelection()) throw SError( SError::SkipEvent );
   //bcc->recoHyps->clear();
   //topfit->CalculateTopTag();
   //m_TagChi2discr->FillDiscriminatorValues();
@@ -608,7 +621,7 @@ void ZPrimeTopTaggerCycle::ExecuteEvent( const SInputData& id, Double_t weight)
 
   if( (pow(deltaRmin(&neutrino, bcc->jets)-.8,2)*1.5625 + pow(pTrel(&muon, bcc->jets),2)*.00308641975) > 1 && (hyp->toplep_v4()+hyp->tophad_v4()).M()>500){
     TagMJets_neutrino_muon->Fill();
-    if(BSel->passSelection())
+    if(m_BSel->passSelection())
       TagMJetsBTag_neutrino_muon->Fill();
     else
       TagMJetsNoBTag_neutrino_muon->Fill();
@@ -617,10 +630,10 @@ void ZPrimeTopTaggerCycle::ExecuteEvent( const SInputData& id, Double_t weight)
   TagScaled->Fill();
   
   /*
-  if(BSel->passSelection()){
+  if(m_BSel->passSelection()){
     TagScaledBTag->Fill();
   }
-  if(NoBSel->passSelection()){
+  if(m_NoBSel->passSelection()){
     TagScaledNoBTag->Fill();
   }
   
@@ -650,7 +663,7 @@ void ZPrimeTopTaggerCycle::ExecuteEvent( const SInputData& id, Double_t weight)
   }
 
   if( (pow(deltaRmin(&neutrino, bcc->jets)-.8,2)*1.5625 + pow(pTrel(&muon, bcc->jets),2)*.00308641975) > 1 && notoptag ==1)NoTagMJets_neutrino_muon->Fill();
-  if(TwoDMuon->passSelection()){
+  if(m_TwoDMuon->passSelection()){
     TagScaledMuonSel_old->Fill();
     TagMuonSel_old->Fill();
     }
@@ -4,6 +4,7 @@ using namespace std;
 
 // Local include(s):
 #include "include/ZprimeEleTrigCycle.h"
+#include "include/HistogramOnlyMode.h"
 
 ClassImp( ZprimeEleTrigCycle );
 
@@ -34,11 +35,22 @@ ZprimeEleTrigCycle::ZprimeEleTrigCycle()
     // steering property for data-driven qcd in electron channel
     m_reversed_electron_selection = false;
     DeclareProperty( "ReversedElectronSelection", m_reversed_electron_selection);
+
+    m_arena = new EventArena();
+
+    // histograms only: no output tree may be configured for the InputData, nothing is written per event
+    m_histogram_only = false;
+    DeclareProperty( "HistogramOnly", m_histogram_only );
+
+    m_event_random = new EventRandom();
+    m_event_random->DeclareProperties(*this);
 }
 
 ZprimeEleTrigCycle::~ZprimeEleTrigCycle()
 {
     // destructor
+    delete m_arena;
+    delete m_event_random;
 }
 
 void ZprimeEleTrigCycle::BeginCycle() throw( SError )
@@ -68,14 +80,18 @@ void ZprimeEleTrigCycle::BeginInputData( const SInputData& id ) throw( SError )
 {
     // declaration of histograms and selections
 
+    if(m_histogram_only) HistogramOnlyMode::Check( id );
+
     // Important: first call BeginInputData of base class
     AnalysisCycle::BeginInputData( id );
 
+    m_event_random->SetSample(id.GetVersion().Data());
+
     // -------------------- set up the selections ---------------------------
 
     //Set-Up Selection
 
-    static Selection* mttbar_gen_selection = new Selection("Mttbar_Gen_Selection");
+    Selection* mttbar_gen_selection = new Selection("Mttbar_Gen_Selection");
     if ( m_mttgencut && ((id.GetVersion() == "TTbar_0to700") || (id.GetVersion() == "TTbar") )  ) {
       m_logger << INFO << "Applying mttbar generator cut from 0 to 700 GeV." << SLogger::endmsg;
       mttbar_gen_selection->addSelectionModule(new MttbarGenCut(0,700));
@@ -188,6 +204,13 @@ void ZprimeEleTrigCycle::BeginInputData( const SInputData& id ) throw( SError )
     // important: initialise histogram collections after their definition
     InitHistos();
 
+    // selections used in ExecuteEvent
+    m_mttbar_gen_selection = GetSelection("Mttbar_Gen_Selection");
+    m_std_mu_selection = GetSelection("std_mu_selection");
+    m_std_mu_selection2 = GetSelection("second_std_mu_selection");
+    m_triangularcut_selection = GetSelection("triangularcut_selection");
+    m_ele_trig_selection = GetSelection("electron_trigger");
+
     return;
 
 }
@@ -197,6 +220,9 @@ void ZprimeEleTrigCycle::EndInputData( const SInputData& id ) throw( SError )
 
     AnalysisCycle::EndInputData( id );
 
+    // release the transient objects of the last event
+    m_arena->Reset();
+
     return;
 }
 
@@ -238,6 +264,8 @@ void ZprimeEleTrigCycle::ExecuteEvent( const SInputData& id, Double_t weight) th
     
     FillTriggerNames();
 
+    m_event_random->SeedEvent(bcc);
+
     // generate random run Nr for MC samples (consider luminosity of each run)
     // e.g. for proper OTX cut in MC, and needs to be done only once per event
     if( !bcc->isRealData && LumiHandler()->IsLumiCalc() ) {
@@ -266,8 +294,7 @@ void ZprimeEleTrigCycle::ExecuteEvent( const SInputData& id, Double_t weight) th
     }
     
     // now start the actual implementation of the electron trigger efficiency
-    static Selection* mttbar_gen_selection = GetSelection("Mttbar_Gen_Selection");
-    if(!mttbar_gen_selection->passSelection())  throw SError( SError::SkipEvent );
+    if(!m_mttbar_gen_selection->passSelection())  throw SError( SError::SkipEvent );
 
     // muon efficiency weights 
     if (!calc->IsRealData()){
@@ -277,12 +304,8 @@ void ZprimeEleTrigCycle::ExecuteEvent( const SInputData& id, Double_t weight) th
     // control histograms
     FillControlHists("_Presel");
 
-    static Selection* std_mu_selection = GetSelection("std_mu_selection");
-    static Selection* std_mu_selection2 = GetSelection("second_std_mu_selection");
-    static Selection* triangularcut_selection = GetSelection("triangularcut_selection");
-    static Selection* ele_trig_selection = GetSelection("electron_trigger");
-
-    m_cleaner = new Cleaner();
+    m_arena->Reset();
+    m_cleaner = m_arena->NewCleaner();
     m_cleaner->SetJECUncertainty(m_jes_unc);
 
     // settings for jet correction uncertainties
@@ -303,7 +326,7 @@ void ZprimeEleTrigCycle::ExecuteEvent( const SInputData& id, Double_t weight) th
 
     // apply loose jet cleaning for 2D cut
     if(bcc->jets) m_cleaner->JetCleaner(25,double_infinity(),true);
-    if(!std_mu_selection->passSelection())  throw SError( SError::SkipEvent );
+    if(!m_std_mu_selection->passSelection())  throw SError( SError::SkipEvent );
 
     //apply tight jet cleaning
     if(bcc->jets) m_cleaner->JetCleaner(30,2.5,true);
@@ -315,20 +338,20 @@ void ZprimeEleTrigCycle::ExecuteEvent( const SInputData& id, Double_t weight) th
     //
     // --------- standard muon selection with electrons allowed ------------
     // 
-    if(!std_mu_selection2->passSelection())  throw SError( SError::SkipEvent );
+    if(!m_std_mu_selection2->passSelection())  throw SError( SError::SkipEvent );
     FillControlHists("_Muonsel");     // control histograms for standard muon selection with 0 or 1 electrons
 
 
     //
     // --------- one electron with triangular cut ------------
     // 
-    if(!triangularcut_selection->passSelection())  throw SError( SError::SkipEvent );
+    if(!m_triangularcut_selection->passSelection())  throw SError( SError::SkipEvent );
     FillControlHists("_Electronsel");
 
     //
     // --------- electron trigger selection ------------
     // 
-    if(!ele_trig_selection->passSelection())  throw SError( SError::SkipEvent );
+    if(!m_ele_trig_selection->passSelection())  throw SError( SError::SkipEvent );
     FillControlHists("_Electrontrig");
 
     // electron efficiency weights
@@ -346,7 +369,7 @@ void ZprimeEleTrigCycle::ExecuteEvent( const SInputData& id, Double_t weight) th
     // BaseHists* Chi2Hists = GetHistCollection("Chi2");
     // Chi2Hists->Fill();
 
-    WriteOutputTree();
+    if(!m_histogram_only) WriteOutputTree();
 
     return;
 }
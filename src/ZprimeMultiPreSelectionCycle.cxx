@@ -0,0 +1,371 @@
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+
+// Local include(s):
+#include "include/ZprimeMultiPreSelectionCycle.h"
+#include "include/SelectionModules.h"
+#include "include/EventIndex.h"
+#include "include/EventListWriter.h"
+#include "JetCorrectorParameters.h"
+
+// ROOT include(s):
+#include <TDirectory.h>
+
+ClassImp( ZprimeMultiPreSelectionCycle );
+
+ZprimeMultiPreSelectionCycle::ZprimeMultiPreSelectionCycle()
+    : AnalysisCycle()
+{
+
+    // constructor, declare additional variables that should be
+    // obtained from the steering-xml file
+
+    // set the integrated luminosity per bin for the lumi-yield control plots
+    SetIntLumiPerBin(25.);
+
+    // steering property for data-driven qcd in electron channel
+    m_reversed_electron_selection = false;
+    DeclareProperty( "ReversedElectronSelection", m_reversed_electron_selection);
+
+    // skims written in one read of the input (space separated): ele mu diele dimu jetht
+    m_channel_names = "ele mu";
+    DeclareProperty( "Channels", m_channel_names );
+    // directory of the skims, must be shared by all workers when running with PROOF
+    m_channel_dir = ".";
+    DeclareProperty( "ChannelOutputDirectory", m_channel_dir );
+
+    m_trig1sel = NULL;
+    m_trig2sel = NULL;
+    m_elesel = NULL;
+    m_muonsel = NULL;
+
+    // read leptons, jets, MET and primary vertices for every event,
+    // all other collections only for events passing one of the channels
+    m_staged_reading = false;
+    DeclareProperty( "StagedReading", m_staged_reading);
+    // additional input branches needed by the preselection (space separated)
+    DeclareProperty( "StagedEarlyBranches", m_staged_early_branches);
+    m_staged_reader = new StagedBranchReader("StagedBranchReader");
+
+    m_electrons_checkpoint = new CollectionCheckpoint<Electron>();
+    m_muons_checkpoint = new CollectionCheckpoint<Muon>();
+    m_jets_checkpoint = new CollectionCheckpoint<Jet>();
+    m_met_checkpoint = new ObjectCheckpoint<MET>();
+
+    // compression of the output trees: "ALGORITHM:LEVEL" with ZLIB, LZMA or LZ4
+    m_output_compression = "";
+    DeclareProperty( "OutputCompression", m_output_compression );
+    m_output_policy = new OutputPolicy("OutputPolicy");
+
+    m_input_cache = new InputCacheMonitor("InputCacheMonitor");
+    m_input_cache->DeclareProperties(*this);
+
+    m_event_random = new EventRandom();
+    m_event_random->DeclareProperties(*this);
+}
+
+ZprimeMultiPreSelectionCycle::~ZprimeMultiPreSelectionCycle()
+{
+    // destructor
+    for(unsigned int i=0; i<m_channels.size(); ++i) CloseChannel(m_channels[i]);
+    delete m_staged_reader;
+    delete m_electrons_checkpoint;
+    delete m_muons_checkpoint;
+    delete m_jets_checkpoint;
+    delete m_met_checkpoint;
+    delete m_output_policy;
+    delete m_input_cache;
+    delete m_event_random;
+}
+
+void ZprimeMultiPreSelectionCycle::BeginCycle() throw( SError )
+{
+    // Start of the job, general set-up and definition of
+    // objects are done here
+
+    // Important: first call BeginCycle of base class
+    AnalysisCycle::BeginCycle();
+
+    return;
+
+}
+
+void ZprimeMultiPreSelectionCycle::EndCycle() throw( SError )
+{
+    // clean-up, info messages and final calculations after the analysis
+
+
+    // call the base cycle class for all standard methods
+    // and a summary of the made selections
+    AnalysisCycle::EndCycle();
+
+    return;
+
+}
+
+void ZprimeMultiPreSelectionCycle::BeginInputData( const SInputData& id ) throw( SError )
+{
+    // declaration of histograms and selections
+
+    // Important: first call BeginInputData of base class
+    AnalysisCycle::BeginInputData( id );
+
+    m_event_random->SetSample(id.GetVersion().Data());
+
+    m_input_cache->Configure();
+
+    if(m_output_compression != "" && !m_output_policy->SetCompression(m_output_compression))
+        throw SError( ("invalid OutputCompression " + m_output_compression).c_str(), SError::StopExecution );
+
+    // -------------------- set up the selections ---------------------------
+
+    // used by the JetHT channel
+    Selection* trig1 = new Selection("HT750_trig");
+    trig1->addSelectionModule(new TriggerSelection("HLT_HT750"));
+    RegisterSelection(trig1);
+
+    Selection* trig2 = new Selection("PFJet320_trig");
+    trig2->addSelectionModule(new TriggerSelection("HLT_PFJet320"));
+    RegisterSelection(trig2);
+
+    Selection* elesel = new Selection("electron");
+    elesel->addSelectionModule(new NElectronSelection(1,int_infinity()));//at least one electron
+    RegisterSelection(elesel);
+
+    Selection* muonsel = new Selection("muon");
+    muonsel->addSelectionModule(new NMuonSelection(1,int_infinity()));//at least one muon
+    RegisterSelection(muonsel);
+
+    m_trig1sel = GetSelection("HT750_trig");
+    m_trig2sel = GetSelection("PFJet320_trig");
+    m_elesel = GetSelection("electron");
+    m_muonsel = GetSelection("muon");
+
+    // one selection per channel, named after it
+    m_channels.clear();
+    std::istringstream names(m_channel_names);
+    std::string name;
+    while(names >> name) {
+        Channel channel;
+        channel.name = name;
+        channel.cleaning = e_CleaningDilepton;
+        channel.jetht = false;
+        channel.file = NULL;
+        channel.tree = NULL;
+        channel.nevents = 0;
+        channel.passed = false;
+
+        Selection* selection = new Selection(name + "_preselection");
+        if(name == "ele") {
+            channel.cleaning = e_CleaningLeptonJets;
+            selection->addSelectionModule(new NElectronSelection(1,int_infinity()));//at least one electron
+            selection->addSelectionModule(new NMuonSelection(0,0));//no muons
+            selection->addSelectionModule(new NJetSelection(2));//at least two jets
+        } else if(name == "mu") {
+            channel.cleaning = e_CleaningLeptonJets;
+            selection->addSelectionModule(new NElectronSelection(0,0));//no electron
+            selection->addSelectionModule(new NMuonSelection(1,int_infinity()));//at least one muon
+            selection->addSelectionModule(new NJetSelection(2));//at least two jets
+        } else if(name == "diele") {
+            selection->addSelectionModule(new NElectronSelection(2,int_infinity()));//at least two electrons
+            selection->addSelectionModule(new NMuonSelection(0,0));//no muons
+        } else if(name == "dimu") {
+            selection->addSelectionModule(new NElectronSelection(0,0));//no electron
+            selection->addSelectionModule(new NMuonSelection(2,int_infinity()));//at least two muons
+        } else if(name == "jetht") {
+            channel.jetht = true;
+            selection->addSelectionModule(new NJetSelection(2));//at least two jets
+        } else {
+            delete selection;
+            throw SError( ("unknown channel " + name + " in Channels --- should be `ele`, `mu`, `diele`, `dimu` or `jetht`").c_str(), SError::StopExecution );
+        }
+        RegisterSelection(selection);
+        channel.selection = GetSelection(name + "_preselection");
+
+        m_channels.push_back(channel);
+    }
+
+    if(m_channels.empty())
+        throw SError( "no channel given in Channels", SError::StopExecution );
+
+    return;
+}
+
+void ZprimeMultiPreSelectionCycle::EndInputData( const SInputData& id ) throw( SError )
+{
+    AnalysisCycle::EndInputData( id );
+
+    m_input_cache->PrintStatistics();
+
+    if(m_staged_reading) m_staged_reader->PrintStatistics();
+
+    for(unsigned int i=0; i<m_channels.size(); ++i) CloseChannel(m_channels[i]);
+
+    return;
+}
+
+void ZprimeMultiPreSelectionCycle::BeginInputFile( const SInputData& id ) throw( SError )
+{
+    // Connect all variables from the Ntuple file with the ones needed for the analysis
+    // The variables are commonly stored in the BaseCycleContaincer
+
+    // important: call to base function to connect all variables to Ntuples from the input tree
+    AnalysisCycle::BeginInputFile( id );
+
+    TTree* input = GetInputTree("AnalysisTree");
+
+    m_input_cache->Setup(input);
+
+    if(m_staged_reading) {
+        BaseCycleContainer* bcc = EventCalc::Instance()->GetBaseCycleContainer();
+        m_staged_reader->AddEarly(&bcc->electrons);
+        m_staged_reader->AddEarly(&bcc->muons);
+        m_staged_reader->AddEarly(&bcc->jets);
+        m_staged_reader->AddEarly(&bcc->met);
+        m_staged_reader->AddEarly(&bcc->pvs);
+        m_staged_reader->AddEarlyBranches(m_staged_early_branches);
+        m_staged_reader->Setup(input);
+    }
+
+    // the output trees share the variables of the input tree
+    for(unsigned int i=0; i<m_channels.size(); ++i) {
+        if(!m_channels[i].tree) OpenChannel(m_channels[i], id, input);
+        else input->CopyAddresses(m_channels[i].tree);
+    }
+
+    return;
+}
+
+void ZprimeMultiPreSelectionCycle::OpenChannel( Channel& channel, const SInputData& id, TTree* input )
+{
+    std::string filename = m_channel_dir + "/ZprimeMultiPreSelectionCycle." + id.GetType().Data() + "." + id.GetVersion().Data()
+        + "." + channel.name + "." + EventListWriter::ProcessId() + ".root";
+
+    TDirectory* directory = gDirectory;
+    channel.file = TFile::Open(filename.c_str(), "RECREATE");
+    if(!channel.file || channel.file->IsZombie()) {
+        directory->cd();
+        throw SError( ("cannot create output file " + filename).c_str(), SError::StopExecution );
+    }
+
+    channel.file->cd();
+    channel.tree = input->CloneTree(0);
+    channel.tree->SetDirectory(channel.file);
+    directory->cd();
+
+    // branches switched off for reading (staged reading) are cloned with their status, but must be filled
+    EventIndex::SetProcess(channel.tree, true);
+
+    if(m_output_compression != "") m_output_policy->Apply(channel.tree);
+
+    m_logger << INFO << "writing channel " << channel.name << " to " << filename << SLogger::endmsg;
+}
+
+void ZprimeMultiPreSelectionCycle::CloseChannel( Channel& channel )
+{
+    if(!channel.file) return;
+
+    channel.file->cd();
+    channel.tree->Write();
+    m_logger << INFO << "channel " << channel.name << ": " << channel.nevents << " events written to "
+             << channel.file->GetName() << SLogger::endmsg;
+    channel.file->Close();
+    delete channel.file;
+    channel.file = NULL;
+    channel.tree = NULL;
+}
+
+void ZprimeMultiPreSelectionCycle::Clean( E_ChannelCleaning cleaning )
+{
+    Cleaner cleaner;
+    BaseCycleContainer* bcc = EventCalc::Instance()->GetBaseCycleContainer();
+
+    if(bcc->muons) cleaner.MuonCleaner_noIso(45,2.1);
+    if(bcc->electrons) {
+        if(cleaning == e_CleaningLeptonJets) cleaner.ElectronCleaner_noIso(35,2.5,m_reversed_electron_selection,true);
+        else cleaner.ElectronCleaner_noIso(35,2.5,m_reversed_electron_selection);
+    }
+    if(bcc->jets) cleaner.JetLeptonSubtractor(m_corrector,false);
+    if(!bcc->isRealData && bcc->jets) cleaner.JetEnergyResolutionShifter();
+    if(bcc->jets) cleaner.JetCleaner(30,2.5,true);
+}
+
+void ZprimeMultiPreSelectionCycle::ExecuteEvent( const SInputData& id, Double_t weight) throw( SError )
+{
+    // this is the most important part: here the full analysis happens
+    // user should implement selections, filling of histograms and results
+
+    m_input_cache->Update();
+
+    m_event_random->SeedEvent(EventCalc::Instance()->GetBaseCycleContainer());
+
+    // first step: call Execute event of base class to perform basic consistency checks
+    // also, the good-run selection is performed there and the calculator is reset
+    AnalysisCycle::ExecuteEvent( id, weight);
+
+    // every cleaning pass draws the JER smearing of the single cycles
+    m_event_random->SaveState();
+
+    EventCalc* calc = EventCalc::Instance();
+    BaseCycleContainer* bcc = calc->GetBaseCycleContainer();
+
+    bool written = false;
+    bool loaded = false;
+
+    for(int cleaning = 0; cleaning < e_NCleanings; ++cleaning) {
+
+        bool used = false;
+        for(unsigned int i=0; i<m_channels.size(); ++i) used = used || m_channels[i].cleaning == cleaning;
+        if(!used) continue;
+
+        //save the uncleaned collections, the next cleaning starts from them
+        m_electrons_checkpoint->Save(bcc->electrons);
+        m_muons_checkpoint->Save(bcc->muons);
+        m_jets_checkpoint->Save(bcc->jets);
+        m_met_checkpoint->Save(bcc->met);
+
+        m_event_random->RestoreState();
+        Clean( (E_ChannelCleaning) cleaning );
+
+        bool passed = false;
+        for(unsigned int i=0; i<m_channels.size(); ++i) {
+            Channel& channel = m_channels[i];
+            channel.passed = false;
+            if(channel.cleaning != cleaning) continue;
+            channel.passed = channel.selection->passSelection();
+            if(channel.passed && channel.jetht) {
+                channel.passed = (m_trig1sel->passSelection() || m_trig2sel->passSelection())
+                    && (m_elesel->passSelection() || m_muonsel->passSelection());
+            }
+            passed = passed || channel.passed;
+        }
+
+        if(passed) {
+            //read the remaining collections for the selected event
+            if(m_staged_reading && !loaded) m_staged_reader->LoadDeferred();
+            loaded = true;
+
+            //the uncleaned jets and MET are stored in the output, the leptons cleaned
+            m_met_checkpoint->Restore();
+            m_jets_checkpoint->Restore();
+
+            for(unsigned int i=0; i<m_channels.size(); ++i) {
+                if(!m_channels[i].passed) continue;
+                m_channels[i].tree->Fill();
+                ++m_channels[i].nevents;
+            }
+            written = true;
+        }
+
+        m_met_checkpoint->Restore();
+        m_jets_checkpoint->Restore();
+        m_muons_checkpoint->Restore();
+        m_electrons_checkpoint->Restore();
+    }
+
+    if(!written) throw SError( SError::SkipEvent );
+
+    return;
+}
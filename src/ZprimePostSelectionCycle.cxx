@@ -5,6 +5,16 @@ using namespace std;
 // Local include(s):
 #include "include/ZprimePostSelectionCycle.h"
 #include "include/EventFilterFromListStandAlone.h"
+#include "include/PDFWeights.h"
+#include "include/SkimBranchFilter.h"
+#include "include/BranchUsageTracker.h"
+#include "include/HistogramOnlyMode.h"
+
+#include <cstdio>
+#include <fstream>
+
+// ROOT include(s):
+#include <TFile.h>
 
 ClassImp( ZprimePostSelectionCycle );
 
@@ -29,6 +39,9 @@ ZprimePostSelectionCycle::ZprimePostSelectionCycle()
     DeclareProperty( "ApplyFlavorSelection", m_flavor_selection );
     DeclareProperty( "EventFilterFile", m_filter_file );
     DeclareProperty( "WriteEventList", m_writeeventlist);
+    // directory of the event lists, must be shared by all workers when running with PROOF
+    m_eventlist_dir = ".";
+    DeclareProperty( "EventListDirectory", m_eventlist_dir);
     DeclareProperty( "CorrectTopPtWeights", m_correctTopPtWeights);
 
     // set the integrated luminosity per bin for the lumi-yield control plots
@@ -41,11 +54,84 @@ ZprimePostSelectionCycle::ZprimePostSelectionCycle()
     // apply SF for the "Ele30 OR PFJet320" trigger (electron channel)
     m_applyEleORJetTriggerSF = false;
     DeclareProperty( "applyEleORJetTriggerSF", m_applyEleORJetTriggerSF);
+
+    // weights of all PDF members per event, stored in <PDFColumnsDirectory>/<version>_<PDFColumnsPDFName>.pdfw:
+    // a job with PDFColumnsWrite=true evaluates the PDF set once and stores all members,
+    // the jobs for the single members read their weight with PDFColumnsIndex
+    // (run them with SystematicUncertainty None, the weight is applied by this cycle)
+    m_pdfcolumns_dir = "";
+    m_pdfcolumns_pdfname = "cteq66";
+    m_pdfcolumns_weightdir = "";
+    m_pdfcolumns_write = false;
+    m_pdfcolumns_index = -1;
+    DeclareProperty( "PDFColumnsDirectory", m_pdfcolumns_dir );
+    DeclareProperty( "PDFColumnsPDFName", m_pdfcolumns_pdfname );
+    DeclareProperty( "PDFColumnsWeightFilesDirectory", m_pdfcolumns_weightdir );
+    DeclareProperty( "PDFColumnsWrite", m_pdfcolumns_write );
+    DeclareProperty( "PDFColumnsIndex", m_pdfcolumns_index );
+
+    m_pdfcolumns = new PDFWeightColumns();
+    m_pdfcolumns_weights = NULL;
+
+    // profiling: list of the input branches read, to be used as SkimBranchesFile of the selection
+    m_used_branches_file = "";
+    DeclareProperty( "UsedBranchesFile", m_used_branches_file );
+    m_input_tree = NULL;
+
+    m_eventlist = new EventListWriter("EventListWriter");
+
+    // process only the events of a run:lumi:event list (e.g. an event list written above),
+    // found through run:lumi:event indices of the input files kept in EventIndexDirectory
+    m_event_selection_list = "";
+    m_event_index_dir = ".";
+    DeclareProperty( "EventSelectionList", m_event_selection_list);
+    DeclareProperty( "EventIndexDirectory", m_event_index_dir);
+    m_event_index = new EventIndex("EventIndex");
+
+    m_input_cache = new InputCacheMonitor("InputCacheMonitor");
+    m_input_cache->DeclareProperties(*this);
+
+    // switch off the input branches not used in the first BranchUsageLearnEvents events (0: read all),
+    // BranchUsageKeep lists further branches used by the framework only after the learning phase
+    m_branch_usage_learn_events = 0;
+    m_branch_usage_keep = "";
+    DeclareProperty( "BranchUsageLearnEvents", m_branch_usage_learn_events );
+    DeclareProperty( "BranchUsageKeep", m_branch_usage_keep );
+    m_branch_usage = new BranchUsageTracker("BranchUsageTracker");
+
+    // flat copies of the input collections, written by the first pass over a skim and
+    // mapped by the following passes (systematic variations, PDF members) instead of reading the tree
+    m_flatcache_dir = "";
+    DeclareProperty( "FlatCacheDirectory", m_flatcache_dir );
+    m_flatcache = new FlatEventCache("FlatEventCache");
+
+    // histograms only: no output tree may be configured for the InputData, nothing is written per event
+    m_histogram_only = false;
+    DeclareProperty( "HistogramOnly", m_histogram_only );
+
+    // Chi2 reconstruction and discriminant, shared by the selections and histograms of all InputData
+    m_chi2discr = new Chi2Discriminator();
+
+    m_proof_scheduler = new ProofPacketScheduler("ProofPacketScheduler");
+    m_proof_scheduler->DeclareProperties(*this);
+
+    m_event_random = new EventRandom();
+    m_event_random->DeclareProperties(*this);
 }
 
 ZprimePostSelectionCycle::~ZprimePostSelectionCycle()
 {
     // destructor
+    delete m_pdfcolumns;
+    delete m_pdfcolumns_weights;
+    delete m_eventlist;
+    delete m_event_index;
+    delete m_input_cache;
+    delete m_branch_usage;
+    delete m_flatcache;
+    delete m_chi2discr;
+    delete m_proof_scheduler;
+    delete m_event_random;
 }
 
 void ZprimePostSelectionCycle::BeginCycle() throw( SError )
@@ -76,9 +162,31 @@ void ZprimePostSelectionCycle::BeginInputData( const SInputData& id ) throw( SEr
 {
     // declaration of histograms and selections
 
+    if(m_histogram_only) HistogramOnlyMode::Check( id );
+
     // Important: first call BeginInputData of base class
     AnalysisCycle::BeginInputData( id );
 
+    m_event_random->SetSample(id.GetVersion().Data());
+
+    m_used_branches.clear();
+
+    m_input_cache->Configure();
+    m_branch_usage->Configure(m_branch_usage_learn_events);
+    m_branch_usage->RequireBranches(m_branch_usage_keep);
+
+    if(m_flatcache_dir != "" && !m_flatcache->NColumns()) {
+        BaseCycleContainer* bcc = EventCalc::Instance()->GetBaseCycleContainer();
+        m_flatcache->AddCollection("electrons", bcc->electrons);
+        m_flatcache->AddCollection("muons", bcc->muons);
+        m_flatcache->AddCollection("taus", bcc->taus);
+        m_flatcache->AddCollection("jets", bcc->jets);
+        m_flatcache->AddCollection("topjets", bcc->topjets);
+        m_flatcache->AddCollection("pvs", bcc->pvs);
+        m_flatcache->AddCollection("genparticles", bcc->genparticles);
+        m_flatcache->AddObject("met", bcc->met);
+    }
+
     // -------------------- set up the selections ---------------------------
 
     bool doEle=false;
@@ -92,9 +200,6 @@ void ZprimePostSelectionCycle::BeginInputData( const SInputData& id ) throw( SEr
         m_logger << ERROR << "Electron_Or_Muon_Selection is not defined in your xml config file --- should be either `ELE` or `MU`" << SLogger::endmsg;
     }
 
-    // Chi2 reconstruction and discriminant
-    static Chi2Discriminator* m_chi2discr = new Chi2Discriminator();
-
     // event filter for HCAL laser events
     // NOTE: the file is missing, therefore the HCAL laser selection is commented out
     //Selection* HCALlaser = new Selection("HCAL_laser_events");
@@ -111,7 +216,7 @@ void ZprimePostSelectionCycle::BeginInputData( const SInputData& id ) throw( SEr
     if (doEle)
         KinematicSelection->addSelectionModule(new HypothesisLeptopPtCut( m_chi2discr, 140.0, double_infinity()));
 
-    static Selection* mttbar_gen_selection = new Selection("Mttbar_Gen_Selection");
+    Selection* mttbar_gen_selection = new Selection("Mttbar_Gen_Selection");
     if ( m_mttgencut && ((id.GetVersion() == "TTbar_0to700") || (id.GetVersion() == "TTbar") || (id.GetVersion().BeginsWith("TT")))  ) {
       m_logger << INFO << "Applying mttbar generator cut from 0 to 700 GeV." << SLogger::endmsg;
       mttbar_gen_selection->addSelectionModule(new MttbarGenCut(0,700));
@@ -390,7 +495,57 @@ void ZprimePostSelectionCycle::BeginInputData( const SInputData& id ) throw( SEr
 
 
     if(m_writeeventlist)
-      m_eventlist.open( id.GetVersion()+"_eventlist.txt" );
+      m_eventlist->Open( m_eventlist_dir + "/" + id.GetVersion().Data() + "_eventlist" );
+
+    m_selected_events.clear();
+    if(m_event_selection_list != "") {
+        ifstream list(m_event_selection_list.c_str());
+        if(!list.is_open())
+            throw SError( ("cannot read EventSelectionList " + m_event_selection_list).c_str(), SError::StopExecution );
+        std::string line;
+        while(std::getline(list, line)) {
+            EventIndex::Record event;
+            if(sscanf(line.c_str(), "%d:%d:%d", &event.run, &event.lumi, &event.event) == 3)
+                m_selected_events.push_back(event);
+        }
+        m_logger << INFO << "Processing only the " << m_selected_events.size() << " events of " << m_event_selection_list << SLogger::endmsg;
+    }
+
+    // PDF weights of all members
+    delete m_pdfcolumns_weights;
+    m_pdfcolumns_weights = NULL;
+    if(PDFColumnsUsed(id)) {
+        std::string basename = PDFColumnsBaseName(id);
+        std::string filename = basename + ".pdfw";
+        if(m_pdfcolumns_write) {
+            // one part per worker, merged into filename by EndMasterInputData
+            m_logger << INFO << "Writing weights of all " << m_pdfcolumns_pdfname << " members to " << filename << SLogger::endmsg;
+            m_pdfcolumns_weights = new PDFWeights(e_Default, m_pdfcolumns_pdfname, m_pdfcolumns_weightdir);
+            if(!m_pdfcolumns->OpenForWriting(basename))
+                throw SError( ("cannot create PDF weight file " + filename).c_str(), SError::StopExecution );
+        } else {
+            if(!m_pdfcolumns->OpenForReading(filename))
+                throw SError( ("cannot read PDF weight file " + filename).c_str(), SError::StopExecution );
+            if(m_pdfcolumns_index < 0 || m_pdfcolumns_index >= (int) m_pdfcolumns->NMembers())
+                throw SError( "PDFColumnsIndex out of range", SError::StopExecution );
+            m_logger << INFO << "Applying weight of " << m_pdfcolumns_pdfname << " member " << m_pdfcolumns_index << SLogger::endmsg;
+        }
+    }
+
+    // selections used in ExecuteEvent
+    m_LeadingJetSelection = GetSelection("LeadingJetSelection");
+    m_KinematicSelection = GetSelection("KinematicSelection");
+    m_TopTagSelection = GetSelection("TopTagSelection");
+    m_Chi2Selection50 = GetSelection("Chi2Selection50");
+    m_Chi2Selection10 = GetSelection("Chi2Selection10");
+    m_BTagSelection = GetSelection("BTagSelection");
+    m_NoBTagSelection = GetSelection("NoBTagSelection");
+    m_CMSSubBTagNsubjSelection = GetSelection("CMSSubBTagNsubjSelection");
+    m_CMSSubBTagSelection = GetSelection("CMSSubBTagSelection");
+    m_SumBTags0Selection = GetSelection("SumBTags0Selection");
+    m_SumBTags1Selection = GetSelection("SumBTags1Selection");
+    m_SumBTags2Selection = GetSelection("SumBTags2Selection");
+    m_mttbar_gen_selection = GetSelection("Mttbar_Gen_Selection");
 
     return;
 }
@@ -417,8 +572,69 @@ void ZprimePostSelectionCycle::EndInputData( const SInputData& id ) throw( SErro
         ScaleHistos("NoTopTagSumBTag2", 1.0 / average );
     }
     AnalysisCycle::EndInputData( id );
+
+    m_input_cache->PrintStatistics();
+    m_branch_usage->PrintStatistics();
+    m_flatcache->Close();
     if(m_writeeventlist)
-      m_eventlist.close();
+      m_eventlist->Close();
+    if(m_pdfcolumns->IsOpen()) {
+        m_pdfcolumns->PrintStatistics();
+        m_pdfcolumns->Close();
+    }
+    // the branches read by this process, merged by EndMasterInputData
+    if(m_used_branches_file != "") {
+        if(!SkimBranchFilter::WriteUsedBranchesPart(m_used_branches, m_used_branches_file))
+            m_logger << ERROR << "Could not write the used input branches of " << m_used_branches_file << SLogger::endmsg;
+    }
+    return;
+}
+
+bool ZprimePostSelectionCycle::PDFColumnsUsed( const SInputData& id ) const
+{
+    return m_pdfcolumns_dir != "" && id.GetType() != "DATA" && id.GetType() != "Data" && id.GetType() != "data";
+}
+
+std::string ZprimePostSelectionCycle::PDFColumnsBaseName( const SInputData& id ) const
+{
+    return m_pdfcolumns_dir + "/" + id.GetVersion().Data() + "_" + m_pdfcolumns_pdfname;
+}
+
+void ZprimePostSelectionCycle::BeginMasterInputData( const SInputData& id ) throw( SError )
+{
+    AnalysisCycle::BeginMasterInputData( id );
+
+    m_proof_scheduler->SetParameters(id.GetVersion().Data());
+
+    // parts of an earlier job must not end up in the merged list
+    if(m_writeeventlist)
+      m_eventlist->RemoveParts( m_eventlist_dir + "/" + id.GetVersion().Data() + "_eventlist" );
+    if(m_pdfcolumns_write && PDFColumnsUsed(id))
+      m_pdfcolumns->RemoveParts( PDFColumnsBaseName(id) );
+    if(m_used_branches_file != "")
+      SkimBranchFilter::RemoveUsedBranchesParts( m_used_branches_file );
+
+    return;
+}
+
+void ZprimePostSelectionCycle::EndMasterInputData( const SInputData& id ) throw( SError )
+{
+    AnalysisCycle::EndMasterInputData( id );
+
+    m_proof_scheduler->PrintSummary();
+
+    // all workers are done: one sorted list for the InputData
+    if(m_writeeventlist)
+      m_eventlist->Merge( m_eventlist_dir + "/" + id.GetVersion().Data() + "_eventlist" );
+    if(m_pdfcolumns_write && PDFColumnsUsed(id) && !m_pdfcolumns->Merge( PDFColumnsBaseName(id) ))
+      throw SError( ("cannot merge the PDF weight files of " + PDFColumnsBaseName(id)).c_str(), SError::StopExecution );
+    if(m_used_branches_file != "") {
+        if(SkimBranchFilter::MergeUsedBranches( m_used_branches_file ))
+            m_logger << INFO << "Wrote the used input branches to " << m_used_branches_file << SLogger::endmsg;
+        else
+            m_logger << ERROR << "Could not write the used input branches to " << m_used_branches_file << SLogger::endmsg;
+    }
+
     return;
 }
 
@@ -430,6 +646,48 @@ void ZprimePostSelectionCycle::BeginInputFile( const SInputData& id ) throw( SEr
     // important: call to base function to connect all variables to Ntuples from the input tree
     AnalysisCycle::BeginInputFile( id );
 
+    m_input_cache->Setup(GetInputTree("AnalysisTree"));
+
+    m_input_tree = GetInputTree("AnalysisTree");
+
+    // collections used by the selection modules and histograms of the framework
+    if(m_branch_usage->IsActive()) {
+        BaseCycleContainer* bcc = EventCalc::Instance()->GetBaseCycleContainer();
+        m_branch_usage->Require(&bcc->electrons);
+        m_branch_usage->Require(&bcc->muons);
+        m_branch_usage->Require(&bcc->taus);
+        m_branch_usage->Require(&bcc->jets);
+        m_branch_usage->Require(&bcc->topjets);
+        m_branch_usage->Require(&bcc->toptagjets);
+        m_branch_usage->Require(&bcc->met);
+        m_branch_usage->Require(&bcc->pvs);
+        m_branch_usage->Require(&bcc->genparticles);
+        // hypotheses of the skim (readTTbarReco), used by the hypothesis cuts and HypothesisHists
+        m_branch_usage->Require(&bcc->recoHyps);
+        m_branch_usage->Setup(m_input_tree);
+    }
+
+    // switches off the branches of the collections found in the cache
+    if(m_flatcache_dir != "" && m_event_selection_list == "")
+        m_flatcache->Open(m_flatcache_dir, m_input_tree->GetCurrentFile()->GetName(), m_input_tree);
+
+    // entries of the selected events in this file, only the event number is read for all other entries
+    if(m_event_selection_list != "") {
+        std::string file = m_input_tree->GetCurrentFile()->GetName();
+        if(!m_event_index->Load(m_event_index_dir, file, m_input_tree)) {
+            m_event_index->Build(m_input_tree);
+            m_event_index->Save(m_event_index_dir, file);
+        }
+        m_selected_entries.clear();
+        for(unsigned int i=0; i<m_selected_events.size(); ++i) {
+            Long64_t entry = m_event_index->Find(m_selected_events[i].run, m_selected_events[i].lumi, m_selected_events[i].event);
+            if(entry >= 0) m_selected_entries.insert(entry);
+        }
+        if(!m_event_index->SkipAll(m_input_tree))
+            throw SError( ("cannot select events of " + file).c_str(), SError::StopExecution );
+        m_logger << INFO << m_selected_entries.size() << " selected events in " << file << SLogger::endmsg;
+    }
+
     return;
 }
 
@@ -438,6 +696,23 @@ void ZprimePostSelectionCycle::ExecuteEvent( const SInputData& id, Double_t weig
     // this is the most important part: here the full analysis happens
     // user should implement selections, filling of histograms and results
 
+    // only the selected events are read, the entry is given by the event number read for every entry;
+    // the branches switched off by the branch usage tracker stay unread
+    if(m_event_selection_list != "") {
+        Long64_t entry = m_event_index->CurrentEntry();
+        if(!m_selected_entries.count(entry)) throw SError( SError::SkipEvent );
+        if(!m_event_index->ReadEntry(entry, m_branch_usage->DisabledBranches())) throw SError( SError::SkipEvent );
+    }
+
+    m_input_cache->Update();
+    m_branch_usage->Update();
+    // all branches of the event are read here; the read state is lost with the tree of the input file
+    if(m_used_branches_file != "") SkimBranchFilter::AddUsedBranches(m_input_tree, m_used_branches);
+    // before the corrections of AnalysisCycle::ExecuteEvent: every pass starts from the uncorrected collections
+    m_flatcache->Load();
+
+    m_event_random->SeedEvent(EventCalc::Instance()->GetBaseCycleContainer());
+
     // first step: call Execute event of base class to perform basic consistency checks
     // also, the good-run selection is performed there and the calculator is reset
     AnalysisCycle::ExecuteEvent( id, weight );
@@ -446,18 +721,6 @@ void ZprimePostSelectionCycle::ExecuteEvent( const SInputData& id, Double_t weig
 
     // get the selections
     //static Selection* HCALlaser = GetSelection("HCAL_laser_events");
-    static Selection* LeadingJetSelection = GetSelection("LeadingJetSelection");
-    static Selection* KinematicSelection = GetSelection("KinematicSelection");
-    static Selection* TopTagSelection = GetSelection("TopTagSelection");
-    static Selection* Chi2Selection50 = GetSelection("Chi2Selection50");
-    static Selection* Chi2Selection10 = GetSelection("Chi2Selection10");
-    static Selection* BTagSelection = GetSelection("BTagSelection");
-    static Selection* NoBTagSelection = GetSelection("NoBTagSelection");
-    static Selection* CMSSubBTagNsubjSelection = GetSelection("CMSSubBTagNsubjSelection");
-    static Selection* CMSSubBTagSelection = GetSelection("CMSSubBTagSelection");
-    static Selection* SumBTags0Selection = GetSelection("SumBTags0Selection");
-    static Selection* SumBTags1Selection = GetSelection("SumBTags1Selection");
-    static Selection* SumBTags2Selection = GetSelection("SumBTags2Selection");
 
     // get the histogram collections
     BaseHists* Chi2_HistsPresel = GetHistCollection("Chi2_Presel");
@@ -484,9 +747,20 @@ void ZprimePostSelectionCycle::ExecuteEvent( const SInputData& id, Double_t weig
     //  if (!HCALlaser->passSelection()) throw SError( SError::SkipEvent );
     //}
 
+    // PDF weights, stored for all events before any cut; MC run numbers are random, use 1 as in the event list
+    if(m_pdfcolumns_weights) {
+        m_pdfcolumns->Fill(1, calc->GetLumiBlock(), calc->GetEventNum(), m_pdfcolumns_weights->GetWeightList());
+    } else if(m_pdfcolumns->IsOpen()) {
+        const std::vector<float>* pdfweights = m_pdfcolumns->Find(1, calc->GetLumiBlock(), calc->GetEventNum());
+        if(!pdfweights) {
+            m_logger << WARNING << "no PDF weights for event " << calc->GetLumiBlock() << ":" << calc->GetEventNum() << ", event skipped" << SLogger::endmsg;
+            throw SError( SError::SkipEvent );
+        }
+        calc->ProduceWeight((*pdfweights)[m_pdfcolumns_index]);
+    }
+
     // cut out events from the inclusive ttbar sample to avoid double counting
-    static Selection* mttbar_gen_selection = GetSelection("Mttbar_Gen_Selection");
-    if(!mttbar_gen_selection->passSelection())  throw SError( SError::SkipEvent );
+    if(!m_mttbar_gen_selection->passSelection())  throw SError( SError::SkipEvent );
 
     // b tagging scale factor
     if(m_bsf && m_addGenInfo) {
@@ -501,40 +775,42 @@ void ZprimePostSelectionCycle::ExecuteEvent( const SInputData& id, Double_t weig
     // Ele30_OR_PFJet320 trigger Scale Factor
     if(m_applyEleORJetTriggerSF && !calc->IsRealData()) calc->ProduceWeight( m_lsf->GetElectronORJetTrigWeight() );
 
-    if(calc->GetJets()->size()>=12) {
-        std::cout << "run: " << calc->GetRunNum() << "   lb: " << calc->GetLumiBlock() << "  event: " << calc->GetEventNum() << "   N(jets): " << calc->GetJets()->size() << std::endl;
+    std::vector<Jet>* jets = m_branch_usage->Use(calc->GetBaseCycleContainer()->jets);
+    if(jets->size()>=12) {
+        std::cout << "run: " << calc->GetRunNum() << "   lb: " << calc->GetLumiBlock() << "  event: " << calc->GetEventNum() << "   N(jets): " << jets->size() << std::endl;
     }
 
     Chi2_HistsPresel->Fill();
     FillControlHistos("_Presel");
 
-    if(!LeadingJetSelection->passSelection())  throw SError( SError::SkipEvent );
+    if(!m_LeadingJetSelection->passSelection())  throw SError( SError::SkipEvent );
 
     Chi2_HistsLJetsel->Fill();
     FillControlHistos("_LJetsel");
 
-    if(!KinematicSelection->passSelection())  throw SError( SError::SkipEvent );
+    if(!m_KinematicSelection->passSelection())  throw SError( SError::SkipEvent );
 
     Chi2_HistsKinesel->Fill();
     FillControlHistos("_Kinesel");
 
-    if(!Chi2Selection50->passSelection()) throw SError( SError::SkipEvent );
+    if(!m_Chi2Selection50->passSelection()) throw SError( SError::SkipEvent );
 
     Chi2_HistsChi2sel->Fill();
     if(m_addGenInfo) BTagEff_HistsChi2selCSVT->Fill();
     if(m_addGenInfo) BTagEff_HistsChi2selCSVM->Fill();
     FillControlHistos("_Chi2sel");
 
-    bool btagged = BTagSelection->passSelection();
-    bool toptagged = TopTagSelection->passSelection();
+    bool btagged = m_BTagSelection->passSelection();
+    bool toptagged = m_TopTagSelection->passSelection();
 
     // BTag-NoBTag categories: do a chi2 selection of 10 for comparison with published analysis
-    if(Chi2Selection10->passSelection()){
-      if(BTagSelection->passSelection()) {
+    bool chi2sel10 = m_Chi2Selection10->passSelection();
+    if(chi2sel10){
+      if(m_BTagSelection->passSelection()) {
         Chi2_HistsBTag->Fill();
         FillControlHistos("_BTag");
       }
-      if(NoBTagSelection->passSelection()) {
+      if(m_NoBTagSelection->passSelection()) {
         Chi2_HistsNoBTag->Fill();
         FillControlHistos("_NoBTag");
       }
@@ -549,15 +825,15 @@ void ZprimePostSelectionCycle::ExecuteEvent( const SInputData& id, Double_t weig
         Chi2_HistsNoTopTagNoBTag->Fill();
         FillControlHistos("_NoTopTagNoBTag");
       }
-      if(SumBTags0Selection->passSelection()){
+      if(m_SumBTags0Selection->passSelection()){
         Chi2_HistsNoTopTagSumBTag0->Fill();
         FillControlHistos("_NoTopTagSumBTag0");
       }
-      if(SumBTags1Selection->passSelection()){
+      if(m_SumBTags1Selection->passSelection()){
         Chi2_HistsNoTopTagSumBTag1->Fill();
         FillControlHistos("_NoTopTagSumBTag1");
       }
-      if(SumBTags2Selection->passSelection()){
+      if(m_SumBTags2Selection->passSelection()){
         Chi2_HistsNoTopTagSumBTag2->Fill();
         FillControlHistos("_NoTopTagSumBTag2");
       }
@@ -568,26 +844,27 @@ void ZprimePostSelectionCycle::ExecuteEvent( const SInputData& id, Double_t weig
       Chi2_HistsTopTag->Fill();
       FillControlHistos("_TopTag");
 
-      if(SumBTags0Selection->passSelection()){
+      if(m_SumBTags0Selection->passSelection()){
         Chi2_HistsTopTagSumBTag0->Fill();
         FillControlHistos("_TopTagSumBTag0");
       }
-      if(SumBTags1Selection->passSelection()){
+      if(m_SumBTags1Selection->passSelection()){
         Chi2_HistsTopTagSumBTag1->Fill();
         FillControlHistos("_TopTagSumBTag1");
       }
-      if(SumBTags2Selection->passSelection()){
+      if(m_SumBTags2Selection->passSelection()){
         Chi2_HistsTopTagSumBTag2->Fill();
         FillControlHistos("_TopTagSumBTag2");
       }
     }
 
     if(m_writeeventlist){
+      UInt_t categories = (btagged ? e_EventListBTag : 0) | (toptagged ? e_EventListTopTag : 0) | (chi2sel10 ? e_EventListChi2Sel10 : 0);
       if(id.GetType()=="DATA" || id.GetType()=="Data" || id.GetType()=="data" )
-	m_eventlist << calc->GetRunNum() << ":" << calc->GetLumiBlock() << ":" << calc->GetEventNum() << std::endl;
+	m_eventlist->Add(calc->GetRunNum(), calc->GetLumiBlock(), calc->GetEventNum(), categories);
       else
 	//don't fill the random run number produced by LumiHandler for MC samples
-	m_eventlist << "1:" << calc->GetLumiBlock() << ":" << calc->GetEventNum() << std::endl;
+	m_eventlist->Add(1, calc->GetLumiBlock(), calc->GetEventNum(), categories);
     }
 
     return;
@@ -9,6 +9,23 @@ using namespace std;
 
 ClassImp( ZprimeSelectionCycle );
 
+namespace {
+
+  // candidates for the CMS-TopTagger: kinematic cuts and no overlap with the lepton
+  struct TopTagCandidate {
+    Particle* lepton;
+    TopTagCandidate(Particle* l): lepton(l) {}
+    bool operator()(const TopJet& topjet) const {
+      // kinematics
+      if(!( topjet.pt() > 400 )) return false;
+      if(!( fabs(topjet.v4().Rapidity()) < 2.4 )) return false;
+      // min distance from lepton
+      return deltaR(topjet.v4(),lepton->v4()) > 0.8;
+    }
+  };
+
+}
+
 ZprimeSelectionCycle::ZprimeSelectionCycle()
     : AnalysisCycle()
 {
@@ -43,11 +60,39 @@ ZprimeSelectionCycle::ZprimeSelectionCycle()
     // put the selected trigger in OR with HLT_PFJet320_v* (electron channel)
     m_useORTriggerWithPFJet320 = false;
     DeclareProperty( "useORTriggerWithPFJet320", m_useORTriggerWithPFJet320);
+
+    // number of events used to measure the modules of the first selection
+    // before reordering them by cost and rejection (0: fixed order)
+    m_adaptive_selection_events = 0;
+    DeclareProperty( "AdaptiveSelectionEvents", m_adaptive_selection_events);
+    m_first_chain = 0;
+
+    m_arena = new EventArena();
+
+    // compression of the output tree: "ALGORITHM:LEVEL" with ZLIB, LZMA or LZ4
+    m_output_compression = "";
+    DeclareProperty( "OutputCompression", m_output_compression );
+    m_output_policy = new OutputPolicy("OutputPolicy");
+
+    // write only these branches (or fields, "branch.field") of the output tree,
+    // given directly (space separated) or in a file written by the next stage with UsedBranchesFile
+    DeclareProperty( "SkimBranches", m_skim_branches );
+    DeclareProperty( "SkimBranchesFile", m_skim_branches_file );
+
+    m_input_cache = new InputCacheMonitor("InputCacheMonitor");
+    m_input_cache->DeclareProperties(*this);
+
+    m_event_random = new EventRandom();
+    m_event_random->DeclareProperties(*this);
 }
 
 ZprimeSelectionCycle::~ZprimeSelectionCycle()
 {
     // destructor
+    delete m_arena;
+    delete m_output_policy;
+    delete m_input_cache;
+    delete m_event_random;
 }
 
 void ZprimeSelectionCycle::BeginCycle() throw( SError )
@@ -80,10 +125,30 @@ void ZprimeSelectionCycle::BeginInputData( const SInputData& id ) throw( SError
     // Important: first call BeginInputData of base class
     AnalysisCycle::BeginInputData( id );
 
+    m_event_random->SetSample(id.GetVersion().Data());
+
+    m_input_cache->Configure();
+
+    // compression of the selected events
+    if(m_output_compression != "") {
+        if(!m_output_policy->SetCompression(m_output_compression))
+            throw SError( ("invalid OutputCompression " + m_output_compression).c_str(), SError::StopExecution );
+        m_output_policy->Apply(GetOutputTree("AnalysisTree"));
+    }
+
+    // branches read by the post-selection
+    if(m_skim_branches != "" || m_skim_branches_file != "") {
+        SkimBranchFilter filter("SkimBranchFilter");
+        filter.AddKeep(m_skim_branches);
+        if(m_skim_branches_file != "" && !filter.ReadKeepFile(m_skim_branches_file))
+            throw SError( ("cannot read SkimBranchesFile " + m_skim_branches_file).c_str(), SError::StopExecution );
+        filter.Apply(GetOutputTree("AnalysisTree"));
+    }
+
     // -------------------- set up the selections ---------------------------
 
     // cut out mttbar events for the 0_to_700 sample to not double-count them
-    static Selection* mttbar_gen_selection = new Selection("Mttbar_Gen_Selection");
+    Selection* mttbar_gen_selection = new Selection("Mttbar_Gen_Selection");
     if ( m_mttgencut && ((id.GetVersion() == "TTbar_0to700") || (id.GetVersion() == "TTbar") )  ) {
       m_logger << INFO << "Applying mttbar generator cut from 0 to 700 GeV." << SLogger::endmsg;
       mttbar_gen_selection->addSelectionModule(new MttbarGenCut(0,700));
@@ -118,22 +183,33 @@ void ZprimeSelectionCycle::BeginInputData( const SInputData& id ) throw( SError
     Selection* trig_selection= new Selection("trig_selection");
     trig_selection->addSelectionModule(new TriggerSelection(m_lumi_trigger));
 
-    Selection* first_selection= new Selection("first_selection");
-    first_selection->addSelectionModule(new NPrimaryVertexSelection(1)); //at least one good PV
-    first_selection->addSelectionModule(new NJetSelection(2,int_infinity(),50,2.4));//at least two jets
+    AdaptiveSelectionChain* first_chain = new AdaptiveSelectionChain("first_selection", m_adaptive_selection_events);
+    first_chain->addSelectionModule(new NPrimaryVertexSelection(1)); //at least one good PV
+    first_chain->addSelectionModule(new NJetSelection(2,int_infinity(),50,2.4));//at least two jets
 
     if(doEle) {
-      first_selection->addSelectionModule(new NElectronSelection(1,int_infinity()));//at least one electron
-      first_selection->addSelectionModule(new NElectronSelection(1,1));//exactly one electron
-      first_selection->addSelectionModule(new NMuonSelection(0,0));//no muons
+      first_chain->addCountSelectionModule(new NElectronSelection(1,int_infinity()), "electrons", 1, int_infinity());//at least one electron
+      first_chain->addCountSelectionModule(new NElectronSelection(1,1), "electrons", 1, 1);//exactly one electron
+      first_chain->addCountSelectionModule(new NMuonSelection(0,0), "muons", 0, 0);//no muons
     }
     if(doMu) {
-      first_selection->addSelectionModule(new NMuonSelection(1,int_infinity()));//at least one muon
-      first_selection->addSelectionModule(new NMuonSelection(1,1));//exactly one muon
-      first_selection->addSelectionModule(new NElectronSelection(0,0));//no ided electrons
+      first_chain->addCountSelectionModule(new NMuonSelection(1,int_infinity()), "muons", 1, int_infinity());//at least one muon
+      first_chain->addCountSelectionModule(new NMuonSelection(1,1), "muons", 1, 1);//exactly one muon
+      first_chain->addCountSelectionModule(new NElectronSelection(0,0), "electrons", 0, 0);//no ided electrons
     }
 
-    first_selection->addSelectionModule(new TwoDCut());
+    first_chain->addSelectionModule(new TwoDCut(), false);//needs the single lepton, keep it last
+
+    Selection* first_selection= new Selection("first_selection");
+    if(m_adaptive_selection_events>0) {
+      m_logger << INFO << "Reordering first_selection after " << m_adaptive_selection_events << " events." << SLogger::endmsg;
+      first_selection->addSelectionModule(first_chain);
+      m_first_chain = first_chain;
+    } else {
+      first_chain->AttachTo(first_selection);
+      delete first_chain;
+      m_first_chain = 0;
+    }
 
     Selection* second_selection= new Selection("second_selection");
 
@@ -215,6 +291,18 @@ void ZprimeSelectionCycle::BeginInputData( const SInputData& id ) throw( SError
     m_cm_sumdr = new HypothesisStatistics("matched vs. SumDR");
     m_cm_bp = new HypothesisStatistics("matched vs. b.p.");
 
+    // selections used in ExecuteEvent
+    m_mttbar_gen_selection = GetSelection("Mttbar_Gen_Selection");
+    m_Ele30trig_selection = GetSelection("Ele30trig_selection");
+    m_PFJet320trig_selection = GetSelection("PFJet320trig_selection");
+    m_trig_selection = GetSelection("trig_selection");
+    m_first_selection = GetSelection("first_selection");
+    m_second_selection = GetSelection("second_selection");
+    m_trangularcut_selection = GetSelection("trangularcut_selection");
+    m_chi2_selection = GetSelection("chi2_selection");
+    m_matchable_selection = GetSelection("matchable_selection");
+    m_TopTagSel = GetSelection("TopTagSelection");
+
     return;
 
 }
@@ -224,6 +312,14 @@ void ZprimeSelectionCycle::EndInputData( const SInputData& id ) throw( SError )
 
     AnalysisCycle::EndInputData( id );
 
+    m_input_cache->PrintStatistics();
+
+    // release the transient objects of the last event
+    m_arena->Reset();
+
+    // the adaptive chain counts as a single module in first_selection
+    if(m_first_chain) m_first_chain->PrintCutFlow();
+
     m_bp_chi2->PrintStatistics();
     m_bp_sumdr->PrintStatistics();
     m_cm_chi2->PrintStatistics();
@@ -247,6 +343,8 @@ void ZprimeSelectionCycle::BeginInputFile( const SInputData& id ) throw( SError
     // important: call to base function to connect all variables to Ntuples from the input tree
     AnalysisCycle::BeginInputFile( id );
 
+    m_input_cache->Setup(GetInputTree("AnalysisTree"));
+
     return;
 }
 
@@ -255,6 +353,10 @@ void ZprimeSelectionCycle::ExecuteEvent( const SInputData& id, Double_t weight)
     // this is the most important part: here the full analysis happens
     // user should implement selections, filling of histograms and results
 
+    m_input_cache->Update();
+
+    m_event_random->SeedEvent(EventCalc::Instance()->GetBaseCycleContainer());
+
     // first step: call Execute event of base class to perform basic consistency checks
     // also, the good-run selection is performed there and the calculator is reset
 
@@ -266,23 +368,14 @@ void ZprimeSelectionCycle::ExecuteEvent( const SInputData& id, Double_t weight)
     TopFitCalc* topcalc = TopFitCalc::Instance();
     topcalc->Reset();
 
-    static Selection* mttbar_gen_selection = GetSelection("Mttbar_Gen_Selection");
-    if(!mttbar_gen_selection->passSelection())  throw SError( SError::SkipEvent );
+    if(!m_mttbar_gen_selection->passSelection())  throw SError( SError::SkipEvent );
 
     // control histograms
     FillControlHists("_Presel");
 
-    static Selection* Ele30trig_selection = GetSelection("Ele30trig_selection");
-    static Selection* PFJet320trig_selection = GetSelection("PFJet320trig_selection");
-    static Selection* trig_selection = GetSelection("trig_selection");
-    static Selection* first_selection = GetSelection("first_selection");
-    static Selection* second_selection = GetSelection("second_selection");
-    static Selection* trangularcut_selection = GetSelection("trangularcut_selection");
-    static Selection* chi2_selection = GetSelection("chi2_selection");
-    static Selection* matchable_selection = GetSelection("matchable_selection");
-    static Selection* TopTagSel = GetSelection("TopTagSelection");
-
-    m_cleaner = new Cleaner();
+
+    m_arena->Reset();
+    m_cleaner = m_arena->NewCleaner();
     m_cleaner->SetJECUncertainty(m_jes_unc);
 
     // settings for jet correction uncertainties
@@ -308,44 +401,28 @@ void ZprimeSelectionCycle::ExecuteEvent( const SInputData& id, Double_t weight)
     // control histograms
     FillControlHists("_Cleaned");
 
-    if(m_veto_electron_trigger && Ele30trig_selection->passSelection()){
+    if(m_veto_electron_trigger && m_Ele30trig_selection->passSelection()){
       throw SError( SError::SkipEvent );
     }
 
     bool triggerbit(0);
-    if(!m_useORTriggerWithPFJet320) triggerbit = trig_selection->passSelection();
-    else triggerbit = trig_selection->passSelection() || PFJet320trig_selection->passSelection();
+    if(!m_useORTriggerWithPFJet320) triggerbit = m_trig_selection->passSelection();
+    else triggerbit = m_trig_selection->passSelection() || m_PFJet320trig_selection->passSelection();
 
     if(!triggerbit)  throw SError( SError::SkipEvent );
 
-    if(!first_selection->passSelection())  throw SError( SError::SkipEvent );
+    if(!m_first_selection->passSelection())  throw SError( SError::SkipEvent );
 
     // manual cleaner for topjet collection
     // keep only candidates for CMS-TopTagger,
-    // i.e. passing kinematic cuts and no lepton-overlap
-    std::vector<TopJet> toptag_jets;
-    Particle* plepton = calc->GetPrimaryLepton();
-
-    for(unsigned int i=0; i<bcc->topjets->size(); ++i){
-
-      TopJet& itopjet = bcc->topjets->at(i);
-
-      // kinematics
-      if(!( itopjet.pt() > 400 )) continue;
-      if(!( fabs(itopjet.v4().Rapidity()) < 2.4 )) continue;
-
-      // min distance from lepton
-      if(!( deltaR(itopjet.v4(),plepton->v4()) > 0.8 )) continue;
-
-      toptag_jets.push_back(itopjet);
-    }
-
-    std::sort(toptag_jets.begin(), toptag_jets.end(), HigherPt());
-
-    bcc->topjets->clear();
-    for(unsigned int i=0; i<toptag_jets.size(); ++i){
-      bcc->topjets->push_back(toptag_jets.at(i));
-    }
+    // i.e. passing kinematic cuts and no lepton-overlap,
+    // filter and order indices and copy the selected jets only once
+    IndexView<TopJet> toptag_view(bcc->topjets);
+    toptag_view.Filter(TopTagCandidate(calc->GetPrimaryLepton())).Sort(HigherPt());
+
+    std::vector<TopJet>& toptag_jets = *m_arena->TopJetCollections().Acquire();
+    toptag_view.Materialize(toptag_jets);
+    bcc->topjets->swap(toptag_jets);
     
     //apply tighter jet cleaning for further cuts and analysis steps
     if(bcc->jets) m_cleaner->JetCleaner(50,2.5,true);
@@ -353,17 +430,17 @@ void ZprimeSelectionCycle::ExecuteEvent( const SInputData& id, Double_t weight)
     //remove all taus from collection for HTlep calculation
     if(bcc->taus) m_cleaner->TauCleaner(double_infinity(),0.0);
 
-    if(!second_selection->passSelection())  throw SError( SError::SkipEvent );
+    if(!m_second_selection->passSelection())  throw SError( SError::SkipEvent );
 
     if(!m_reversed_electron_selection) {
-        if(!trangularcut_selection->passSelection())  throw SError( SError::SkipEvent );
+        if(!m_trangularcut_selection->passSelection())  throw SError( SError::SkipEvent );
     } else {
-        if(!trangularcut_selection->passInvertedSelection())  throw SError( SError::SkipEvent );
+        if(!m_trangularcut_selection->passInvertedSelection())  throw SError( SError::SkipEvent );
     }
     
     //do reconstruction here
     //if(!bcc->recoHyps)  cout<<"no Hyp list"<<endl;
-    if(TopTagSel->passSelection()){
+    if(m_TopTagSel->passSelection()){
       topcalc->CalculateTopTag();
       //topcalc->FillHighMassTTbarHypotheses();
     } else{
@@ -375,8 +452,8 @@ void ZprimeSelectionCycle::ExecuteEvent( const SInputData& id, Double_t weight)
     m_sumdrdiscr->FillDiscriminatorValues();
     m_cmdiscr->FillDiscriminatorValues();
 
-    //if(!chi2_selection->passSelection())  throw SError( SError::SkipEvent );
-    //if(!matchable_selection->passSelection())  throw SError( SError::SkipEvent );
+    //if(!m_chi2_selection->passSelection())  throw SError( SError::SkipEvent );
+    //if(!m_matchable_selection->passSelection())  throw SError( SError::SkipEvent );
 
     ReconstructionHypothesis *hyp = m_chi2discr->GetBestHypothesis();
 
@@ -24,11 +24,17 @@ ZprimeSelectionDataTrigTestCycle::ZprimeSelectionDataTrigTestCycle()
   DeclareProperty( "Nbtags_min", m_Nbtags_min);
   DeclareProperty( "Nbtags_max", m_Nbtags_max);  
 
+  m_arena = new EventArena();
+
+  m_event_random = new EventRandom();
+  m_event_random->DeclareProperties(*this);
 }
 
 ZprimeSelectionDataTrigTestCycle::~ZprimeSelectionDataTrigTestCycle() 
 {
   // destructor
+  delete m_arena;
+  delete m_event_random;
 }
 
 void ZprimeSelectionDataTrigTestCycle::BeginCycle() throw( SError ) 
@@ -62,6 +68,8 @@ void ZprimeSelectionDataTrigTestCycle::BeginInputData( const SInputData& id ) th
   // Important: first call BeginInputData of base class
   AnalysisCycle::BeginInputData( id );
 
+  m_event_random->SetSample(id.GetVersion().Data());
+
   // -------------------- set up the selections ---------------------------
 
   //Set-Up Selection
@@ -149,6 +157,13 @@ void ZprimeSelectionDataTrigTestCycle::BeginInputData( const SInputData& id ) th
   // important: initialise histogram collections after their definition
   InitHistos();
 
+  // selections used in ExecuteEvent
+  m_trig_selection = GetSelection("trig_selection");
+  m_reftrig_selection = GetSelection("reftrig_selection");
+  m_first_selection = GetSelection("first_selection");
+  m_second_selection = GetSelection("second_selection");
+  m_chi2_selection = GetSelection("chi2_selection");
+
   return;
 
 }
@@ -199,6 +214,10 @@ void ZprimeSelectionDataTrigTestCycle::EndInputData( const SInputData& id ) thro
   }*/
 
   AnalysisCycle::EndInputData( id );
+
+  // release the transient objects of the last event
+  m_arena->Reset();
+
   return;
 
 }
@@ -220,17 +239,15 @@ void ZprimeSelectionDataTrigTestCycle::ExecuteEvent( const SInputData& id, Doubl
   // this is the most important part: here the full analysis happens
   // user should implement selections, filling of histograms and results
 
+  m_event_random->SeedEvent(EventCalc::Instance()->GetBaseCycleContainer());
+
   // first step: call Execute event of base class to perform basic consistency checks
   // also, the good-run selection is performed there and the calculator is reset
   AnalysisCycle::ExecuteEvent( id, weight);
   
-  static Selection* trig_selection = GetSelection("trig_selection");
-  static Selection* reftrig_selection = GetSelection("reftrig_selection");
-  static Selection* first_selection = GetSelection("first_selection");
-  static Selection* second_selection = GetSelection("second_selection");
-  static Selection* chi2_selection = GetSelection("chi2_selection");
  
-  m_cleaner = new Cleaner();
+  m_arena->Reset();
+  m_cleaner = m_arena->NewCleaner();
 
   EventCalc* calc = EventCalc::Instance();
   BaseCycleContainer* bcc = calc->GetBaseCycleContainer();
@@ -245,7 +262,7 @@ void ZprimeSelectionDataTrigTestCycle::ExecuteEvent( const SInputData& id, Doubl
   if(bcc->jets) m_cleaner->JetCleaner(25,double_infinity(),true);
 
 
-  if(!first_selection->passSelection())  throw SError( SError::SkipEvent );
+  if(!m_first_selection->passSelection())  throw SError( SError::SkipEvent );
 
   //apply tighter jet cleaning for further cuts and analysis steps
   if(bcc->jets) m_cleaner->JetCleaner(50,2.5,true);
@@ -253,7 +270,7 @@ void ZprimeSelectionDataTrigTestCycle::ExecuteEvent( const SInputData& id, Doubl
   //remove all taus from collection for HTlep calculation
   if(bcc->taus) m_cleaner->TauCleaner(double_infinity(),0.0);
 
-  if(!second_selection->passSelection())  throw SError( SError::SkipEvent );
+  if(!m_second_selection->passSelection())  throw SError( SError::SkipEvent );
 
 
   //do reconstruction here
@@ -287,7 +304,7 @@ void ZprimeSelectionDataTrigTestCycle::ExecuteEvent( const SInputData& id, Doubl
   //BaseHists* Chi2Hists = GetHistCollection("Chi2");
   //BaseHists* BPHists = GetHistCollection("BestPossible");
 
-  //if(!chi2_selection->passSelection())  throw SError( SError::SkipEvent );
+  //if(!m_chi2_selection->passSelection())  throw SError( SError::SkipEvent );
 
   //Chi2Hists->Fill();
   //BPHists->Fill();
@@ -301,12 +318,12 @@ void ZprimeSelectionDataTrigTestCycle::ExecuteEvent( const SInputData& id, Doubl
   
   bool trigpass = false;
   bool reftrigpass = false;
-  if(trig_selection->passSelection())
+  if(m_trig_selection->passSelection())
     trigpass = true;
-  if(reftrig_selection->passSelection())
+  if(m_reftrig_selection->passSelection())
 	  reftrigpass = true;
   bool chi2pass = false;
-  if(chi2_selection->passSelection())
+  if(m_chi2_selection->passSelection())
     chi2pass = true;
   if(trigpass && reftrigpass){
   	test_histos->Fill();
@@ -24,11 +24,17 @@ ZprimeSelectionTrigTestCycle::ZprimeSelectionTrigTestCycle()
   DeclareProperty( "Nbtags_min", m_Nbtags_min);
   DeclareProperty( "Nbtags_max", m_Nbtags_max);  
 
+  m_arena = new EventArena();
+
+  m_event_random = new EventRandom();
+  m_event_random->DeclareProperties(*this);
 }
 
 ZprimeSelectionTrigTestCycle::~ZprimeSelectionTrigTestCycle() 
 {
   // destructor
+  delete m_arena;
+  delete m_event_random;
 }
 
 void ZprimeSelectionTrigTestCycle::BeginCycle() throw( SError ) 
@@ -62,6 +68,8 @@ void ZprimeSelectionTrigTestCycle::BeginInputData( const SInputData& id ) throw(
   // Important: first call BeginInputData of base class
   AnalysisCycle::BeginInputData( id );
 
+  m_event_random->SetSample(id.GetVersion().Data());
+
   // -------------------- set up the selections ---------------------------
 
   //Set-Up Selection
@@ -148,6 +156,12 @@ void ZprimeSelectionTrigTestCycle::BeginInputData( const SInputData& id ) throw(
   // important: initialise histogram collections after their definition
   InitHistos();
 
+  // selections used in ExecuteEvent
+  m_trig_selection = GetSelection("trig_selection");
+  m_first_selection = GetSelection("first_selection");
+  m_second_selection = GetSelection("second_selection");
+  m_chi2_selection = GetSelection("chi2_selection");
+
   return;
 
 }
@@ -198,6 +212,10 @@ void ZprimeSelectionTrigTestCycle::EndInputData( const SInputData& id ) throw( S
   }*/
 
   AnalysisCycle::EndInputData( id );
+
+  // release the transient objects of the last event
+  m_arena->Reset();
+
   return;
 
 }
@@ -219,16 +237,15 @@ void ZprimeSelectionTrigTestCycle::ExecuteEvent( const SInputData& id, Double_t
   // this is the most important part: here the full analysis happens
   // user should implement selections, filling of histograms and results
 
+  m_event_random->SeedEvent(EventCalc::Instance()->GetBaseCycleContainer());
+
   // first step: call Execute event of base class to perform basic consistency checks
   // also, the good-run selection is performed there and the calculator is reset
   AnalysisCycle::ExecuteEvent( id, weight);
   
-  static Selection* trig_selection = GetSelection("trig_selection");
-  static Selection* first_selection = GetSelection("first_selection");
-  static Selection* second_selection = GetSelection("second_selection");
-  static Selection* chi2_selection = GetSelection("chi2_selection");
  
-  m_cleaner = new Cleaner();
+  m_arena->Reset();
+  m_cleaner = m_arena->NewCleaner();
 
   EventCalc* calc = EventCalc::Instance();
   BaseCycleContainer* bcc = calc->GetBaseCycleContainer();
@@ -243,7 +260,7 @@ void ZprimeSelectionTrigTestCycle::ExecuteEvent( const SInputData& id, Double_t
   if(bcc->jets) m_cleaner->JetCleaner(25,double_infinity(),true);
 
 
-  if(!first_selection->passSelection())  throw SError( SError::SkipEvent );
+  if(!m_first_selection->passSelection())  throw SError( SError::SkipEvent );
 
   //apply tighter jet cleaning for further cuts and analysis steps
   if(bcc->jets) m_cleaner->JetCleaner(50,2.5,true);
@@ -251,7 +268,7 @@ void ZprimeSelectionTrigTestCycle::ExecuteEvent( const SInputData& id, Double_t
   //remove all taus from collection for HTlep calculation
   if(bcc->taus) m_cleaner->TauCleaner(double_infinity(),0.0);
 
-  if(!second_selection->passSelection())  throw SError( SError::SkipEvent );
+  if(!m_second_selection->passSelection())  throw SError( SError::SkipEvent );
 
 
   //do reconstruction here
@@ -285,7 +302,7 @@ void ZprimeSelectionTrigTestCycle::ExecuteEvent( const SInputData& id, Double_t
   //BaseHists* Chi2Hists = GetHistCollection("Chi2");
   //BaseHists* BPHists = GetHistCollection("BestPossible");
 
-  //if(!chi2_selection->passSelection())  throw SError( SError::SkipEvent );
+  //if(!m_chi2_selection->passSelection())  throw SError( SError::SkipEvent );
 
   //Chi2Hists->Fill();
   //BPHists->Fill();
@@ -304,10 +321,10 @@ void ZprimeSelectionTrigTestCycle::ExecuteEvent( const SInputData& id, Double_t
   standard_histos->Fill();
   jethistos_nochi2->Fill();
   bool trigpass = false;
-  if(trig_selection->passSelection())
+  if(m_trig_selection->passSelection())
     trigpass = true;
   bool chi2pass = false;
-  if(chi2_selection->passSelection())
+  if(m_chi2_selection->passSelection())
     chi2pass = true;
   if(trigpass){
     test_histos->Fill();